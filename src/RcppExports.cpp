@@ -34,6 +34,20 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// estimateKernelApproximationError
+arma::vec estimateKernelApproximationError(const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, const arma::uvec& landmark_rows, const arma::uvec& subsample_rows);
+RcppExport SEXP _AMKAT_estimateKernelApproximationError(SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP landmark_rowsSEXP, SEXP subsample_rowsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type subsample_rows(subsample_rowsSEXP);
+    rcpp_result_gen = Rcpp::wrap(estimateKernelApproximationError(x, candidate_kernels, landmark_rows, subsample_rows));
+    return rcpp_result_gen;
+END_RCPP
+}
 // estimateSignalToNoise
 double estimateSignalToNoise(const arma::vec& y, double y_variance, const arma::mat& kernel_matrix);
 RcppExport SEXP _AMKAT_estimateSignalToNoise(SEXP ySEXP, SEXP y_varianceSEXP, SEXP kernel_matrixSEXP) {
@@ -47,21 +61,90 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// fitNullModel
+Rcpp::List fitNullModel(const arma::mat& y, const arma::mat& covariates);
+RcppExport SEXP _AMKAT_fitNullModel(SEXP ySEXP, SEXP covariatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type y(ySEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type covariates(covariatesSEXP);
+    rcpp_result_gen = Rcpp::wrap(fitNullModel(y, covariates));
+    return rcpp_result_gen;
+END_RCPP
+}
+// generateAmkatBatchStats
+Rcpp::List generateAmkatBatchStats(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::List& x_sets, const Rcpp::CharacterVector& candidate_kernels, bool filter_x, int num_test_statistics, int num_permutations, int max_exceedances, int num_threads, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generateAmkatBatchStats(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP x_setsSEXP, SEXP candidate_kernelsSEXP, SEXP filter_xSEXP, SEXP num_test_statisticsSEXP, SEXP num_permutationsSEXP, SEXP max_exceedancesSEXP, SEXP num_threadsSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type y(ySEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type y_variances(y_variancesSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type x_sets(x_setsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
+    Rcpp::traits::input_parameter< bool >::type filter_x(filter_xSEXP);
+    Rcpp::traits::input_parameter< int >::type num_test_statistics(num_test_statisticsSEXP);
+    Rcpp::traits::input_parameter< int >::type num_permutations(num_permutationsSEXP);
+    Rcpp::traits::input_parameter< int >::type max_exceedances(max_exceedancesSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generateAmkatBatchStats(y, y_variances, x, x_sets, candidate_kernels, filter_x, num_test_statistics, num_permutations, max_exceedances, num_threads, landmark_rows, kernel_storage));
+    return rcpp_result_gen;
+END_RCPP
+}
 // generateKernelMatrix
-arma::mat generateKernelMatrix(const arma::mat& x, const Rcpp::String& kernel_function);
+arma::mat generateKernelMatrix(const arma::mat& x, const std::string& kernel_function);
 RcppExport SEXP _AMKAT_generateKernelMatrix(SEXP xSEXP, SEXP kernel_functionSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
-    Rcpp::traits::input_parameter< const Rcpp::String& >::type kernel_function(kernel_functionSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_function(kernel_functionSEXP);
     rcpp_result_gen = Rcpp::wrap(generateKernelMatrix(x, kernel_function));
     return rcpp_result_gen;
 END_RCPP
 }
+// generateMultiPhenotypeStats
+Rcpp::List generateMultiPhenotypeStats(const Rcpp::List& y_list, const Rcpp::List& y_variances_list, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_permutations, int max_exceedances, int num_threads, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generateMultiPhenotypeStats(SEXP y_listSEXP, SEXP y_variances_listSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_permutationsSEXP, SEXP max_exceedancesSEXP, SEXP num_threadsSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type y_list(y_listSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List& >::type y_variances_list(y_variances_listSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
+    Rcpp::traits::input_parameter< int >::type num_permutations(num_permutationsSEXP);
+    Rcpp::traits::input_parameter< int >::type max_exceedances(max_exceedancesSEXP);
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generateMultiPhenotypeStats(y_list, y_variances_list, x, candidate_kernels, num_permutations, max_exceedances, num_threads, landmark_rows, kernel_storage));
+    return rcpp_result_gen;
+END_RCPP
+}
+// generateNullMomentsNoFilter
+Rcpp::List generateNullMomentsNoFilter(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generateNullMomentsNoFilter(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::mat& >::type y(ySEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type y_variances(y_variancesSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generateNullMomentsNoFilter(y, y_variances, x, candidate_kernels, landmark_rows, kernel_storage));
+    return rcpp_result_gen;
+END_RCPP
+}
 // generatePermStats
-arma::vec generatePermStats(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_permutations);
-RcppExport SEXP _AMKAT_generatePermStats(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_permutationsSEXP) {
+arma::vec generatePermStats(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_permutations, int num_threads, double test_statistic, int max_exceedances, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generatePermStats(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_permutationsSEXP, SEXP num_threadsSEXP, SEXP test_statisticSEXP, SEXP max_exceedancesSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -70,13 +153,18 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
     Rcpp::traits::input_parameter< int >::type num_permutations(num_permutationsSEXP);
-    rcpp_result_gen = Rcpp::wrap(generatePermStats(y, y_variances, x, candidate_kernels, num_permutations));
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< double >::type test_statistic(test_statisticSEXP);
+    Rcpp::traits::input_parameter< int >::type max_exceedances(max_exceedancesSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generatePermStats(y, y_variances, x, candidate_kernels, num_permutations, num_threads, test_statistic, max_exceedances, landmark_rows, kernel_storage));
     return rcpp_result_gen;
 END_RCPP
 }
 // generatePermStatsNoFilter
-arma::vec generatePermStatsNoFilter(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_permutations);
-RcppExport SEXP _AMKAT_generatePermStatsNoFilter(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_permutationsSEXP) {
+arma::vec generatePermStatsNoFilter(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_permutations, int num_threads, double test_statistic, int max_exceedances, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generatePermStatsNoFilter(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_permutationsSEXP, SEXP num_threadsSEXP, SEXP test_statisticSEXP, SEXP max_exceedancesSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -85,13 +173,18 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
     Rcpp::traits::input_parameter< int >::type num_permutations(num_permutationsSEXP);
-    rcpp_result_gen = Rcpp::wrap(generatePermStatsNoFilter(y, y_variances, x, candidate_kernels, num_permutations));
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< double >::type test_statistic(test_statisticSEXP);
+    Rcpp::traits::input_parameter< int >::type max_exceedances(max_exceedancesSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generatePermStatsNoFilter(y, y_variances, x, candidate_kernels, num_permutations, num_threads, test_statistic, max_exceedances, landmark_rows, kernel_storage));
     return rcpp_result_gen;
 END_RCPP
 }
 // generateTestStat
-Rcpp::List generateTestStat(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels);
-RcppExport SEXP _AMKAT_generateTestStat(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP) {
+Rcpp::List generateTestStat(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generateTestStat(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -99,13 +192,15 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const arma::vec& >::type y_variances(y_variancesSEXP);
     Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
-    rcpp_result_gen = Rcpp::wrap(generateTestStat(y, y_variances, x, candidate_kernels));
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generateTestStat(y, y_variances, x, candidate_kernels, landmark_rows, kernel_storage));
     return rcpp_result_gen;
 END_RCPP
 }
 // generateTestStatMultiple
-arma::vec generateTestStatMultiple(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_test_statistics);
-RcppExport SEXP _AMKAT_generateTestStatMultiple(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_test_statisticsSEXP) {
+arma::vec generateTestStatMultiple(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_test_statistics, int num_threads, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generateTestStatMultiple(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_test_statisticsSEXP, SEXP num_threadsSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -114,13 +209,16 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
     Rcpp::traits::input_parameter< int >::type num_test_statistics(num_test_statisticsSEXP);
-    rcpp_result_gen = Rcpp::wrap(generateTestStatMultiple(y, y_variances, x, candidate_kernels, num_test_statistics));
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generateTestStatMultiple(y, y_variances, x, candidate_kernels, num_test_statistics, num_threads, landmark_rows, kernel_storage));
     return rcpp_result_gen;
 END_RCPP
 }
 // generateTestStatNoFilter
-Rcpp::List generateTestStatNoFilter(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels);
-RcppExport SEXP _AMKAT_generateTestStatNoFilter(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP) {
+Rcpp::List generateTestStatNoFilter(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generateTestStatNoFilter(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -128,13 +226,15 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const arma::vec& >::type y_variances(y_variancesSEXP);
     Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
-    rcpp_result_gen = Rcpp::wrap(generateTestStatNoFilter(y, y_variances, x, candidate_kernels));
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generateTestStatNoFilter(y, y_variances, x, candidate_kernels, landmark_rows, kernel_storage));
     return rcpp_result_gen;
 END_RCPP
 }
 // generateTestStatsAllResults
-Rcpp::List generateTestStatsAllResults(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_test_statistics);
-RcppExport SEXP _AMKAT_generateTestStatsAllResults(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_test_statisticsSEXP) {
+Rcpp::List generateTestStatsAllResults(const arma::mat& y, const arma::vec& y_variances, const arma::mat& x, const Rcpp::CharacterVector& candidate_kernels, int num_test_statistics, int num_threads, const arma::uvec& landmark_rows, const std::string& kernel_storage);
+RcppExport SEXP _AMKAT_generateTestStatsAllResults(SEXP ySEXP, SEXP y_variancesSEXP, SEXP xSEXP, SEXP candidate_kernelsSEXP, SEXP num_test_statisticsSEXP, SEXP num_threadsSEXP, SEXP landmark_rowsSEXP, SEXP kernel_storageSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -143,7 +243,10 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const arma::mat& >::type x(xSEXP);
     Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type candidate_kernels(candidate_kernelsSEXP);
     Rcpp::traits::input_parameter< int >::type num_test_statistics(num_test_statisticsSEXP);
-    rcpp_result_gen = Rcpp::wrap(generateTestStatsAllResults(y, y_variances, x, candidate_kernels, num_test_statistics));
+    Rcpp::traits::input_parameter< int >::type num_threads(num_threadsSEXP);
+    Rcpp::traits::input_parameter< const arma::uvec& >::type landmark_rows(landmark_rowsSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type kernel_storage(kernel_storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(generateTestStatsAllResults(y, y_variances, x, candidate_kernels, num_test_statistics, num_threads, landmark_rows, kernel_storage));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -172,20 +275,64 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// validatePhilox
+arma::vec validatePhilox(const arma::vec& counter, const arma::vec& key);
+RcppExport SEXP _AMKAT_validatePhilox(SEXP counterSEXP, SEXP keySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::vec& >::type counter(counterSEXP);
+    Rcpp::traits::input_parameter< const arma::vec& >::type key(keySEXP);
+    rcpp_result_gen = Rcpp::wrap(validatePhilox(counter, key));
+    return rcpp_result_gen;
+END_RCPP
+}
+// validateSnrVariance
+Rcpp::List validateSnrVariance(const arma::vec& y, double y_variance, const arma::mat& kernel_matrix);
+RcppExport SEXP _AMKAT_validateSnrVariance(SEXP ySEXP, SEXP y_varianceSEXP, SEXP kernel_matrixSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const arma::vec& >::type y(ySEXP);
+    Rcpp::traits::input_parameter< double >::type y_variance(y_varianceSEXP);
+    Rcpp::traits::input_parameter< const arma::mat& >::type kernel_matrix(kernel_matrixSEXP);
+    rcpp_result_gen = Rcpp::wrap(validateSnrVariance(y, y_variance, kernel_matrix));
+    return rcpp_result_gen;
+END_RCPP
+}
+// validateSpearmanTailTable
+Rcpp::List validateSpearmanTailTable(int n);
+RcppExport SEXP _AMKAT_validateSpearmanTailTable(SEXP nSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< int >::type n(nSEXP);
+    rcpp_result_gen = Rcpp::wrap(validateSpearmanTailTable(n));
+    return rcpp_result_gen;
+END_RCPP
+}
 
 static const R_CallMethodDef CallEntries[] = {
     {"_AMKAT_applyAmkatFilter", (DL_FUNC) &_AMKAT_applyAmkatFilter, 2},
     {"_AMKAT_computeSampleRanks", (DL_FUNC) &_AMKAT_computeSampleRanks, 1},
+    {"_AMKAT_estimateKernelApproximationError", (DL_FUNC) &_AMKAT_estimateKernelApproximationError, 4},
     {"_AMKAT_estimateSignalToNoise", (DL_FUNC) &_AMKAT_estimateSignalToNoise, 3},
+    {"_AMKAT_fitNullModel", (DL_FUNC) &_AMKAT_fitNullModel, 2},
+    {"_AMKAT_generateAmkatBatchStats", (DL_FUNC) &_AMKAT_generateAmkatBatchStats, 12},
     {"_AMKAT_generateKernelMatrix", (DL_FUNC) &_AMKAT_generateKernelMatrix, 2},
-    {"_AMKAT_generatePermStats", (DL_FUNC) &_AMKAT_generatePermStats, 5},
-    {"_AMKAT_generatePermStatsNoFilter", (DL_FUNC) &_AMKAT_generatePermStatsNoFilter, 5},
-    {"_AMKAT_generateTestStat", (DL_FUNC) &_AMKAT_generateTestStat, 4},
-    {"_AMKAT_generateTestStatMultiple", (DL_FUNC) &_AMKAT_generateTestStatMultiple, 5},
-    {"_AMKAT_generateTestStatNoFilter", (DL_FUNC) &_AMKAT_generateTestStatNoFilter, 4},
-    {"_AMKAT_generateTestStatsAllResults", (DL_FUNC) &_AMKAT_generateTestStatsAllResults, 5},
+    {"_AMKAT_generateMultiPhenotypeStats", (DL_FUNC) &_AMKAT_generateMultiPhenotypeStats, 9},
+    {"_AMKAT_generateNullMomentsNoFilter", (DL_FUNC) &_AMKAT_generateNullMomentsNoFilter, 6},
+    {"_AMKAT_generatePermStats", (DL_FUNC) &_AMKAT_generatePermStats, 10},
+    {"_AMKAT_generatePermStatsNoFilter", (DL_FUNC) &_AMKAT_generatePermStatsNoFilter, 10},
+    {"_AMKAT_generateTestStat", (DL_FUNC) &_AMKAT_generateTestStat, 6},
+    {"_AMKAT_generateTestStatMultiple", (DL_FUNC) &_AMKAT_generateTestStatMultiple, 8},
+    {"_AMKAT_generateTestStatNoFilter", (DL_FUNC) &_AMKAT_generateTestStatNoFilter, 6},
+    {"_AMKAT_generateTestStatsAllResults", (DL_FUNC) &_AMKAT_generateTestStatsAllResults, 8},
     {"_AMKAT_getTailAreaSpearmanRho", (DL_FUNC) &_AMKAT_getTailAreaSpearmanRho, 3},
     {"_AMKAT_testSpearmanRho", (DL_FUNC) &_AMKAT_testSpearmanRho, 2},
+    {"_AMKAT_validatePhilox", (DL_FUNC) &_AMKAT_validatePhilox, 2},
+    {"_AMKAT_validateSnrVariance", (DL_FUNC) &_AMKAT_validateSnrVariance, 3},
+    {"_AMKAT_validateSpearmanTailTable", (DL_FUNC) &_AMKAT_validateSpearmanTailTable, 1},
     {NULL, NULL, 0}
 };
 
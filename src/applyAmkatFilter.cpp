@@ -19,42 +19,135 @@
 
 #include <RcppArmadillo.h>
 
-#include "testSpearmanRho.h"
-#include "getTailAreaSpearmanRho.h"
-#include "computeSampleRanks.h"
+#include "computePvalueSpearmanRho.h"
+#include "computeRankCache.h"
+#include "generatePermutation.h"
+#include "applyAmkatFilter.h"
 
 using namespace arma;
 
-// NOTE: assumes 'y' and 'x' have the same number of rows
-// [[Rcpp::export]]
-arma::uvec applyAmkatFilter(const arma::mat& y,
-                            const arma::mat& x) {
-// for each column of x: tests Spearman's Rho with each column of y; if the
-// minimum p-value is less than the value obtained using a permuted copy of x,
-// the column is kept. If no columns of x are kept, the column with the lowest
-// minimum p-value is kept by default
-  const arma::uword sample_size = y.n_rows;
-  const arma::uword num_x_variables = x.n_cols;
-  const int n(sample_size);
-  const int p(num_x_variables);
-  const arma::mat x_permuted_rows(x.rows(randperm(n)));
-  arma::vec min_pvalue(p, fill::ones);
-  arma::vec min_pvalue_perm(p, fill::ones);
-  double p_value;
-  for (arma::uword i = 0; i < num_x_variables; ++i) {
-    for (arma::uword j = 0; j < y.n_cols; ++j) {
-      p_value = testSpearmanRho(y.col(j), x.col(i));
-      min_pvalue[i] = std::min(p_value, min_pvalue[i]);
-      p_value = testSpearmanRho(y.col(j), x_permuted_rows.col(i));
-      min_pvalue_perm[i] = std::min(p_value, min_pvalue_perm[i]);
+namespace {
+
+// entry i is the minimum, over the columns j of y, of the p-value of
+// Spearman's rho between column i of x and column j of y, read from entry
+// (i, first_column + j) of 'rho'
+arma::vec computeMinPvalues(const arma::mat& rho,
+                            arma::uword first_column,
+                            const RankCache& y_ranks,
+                            const RankCache& x_ranks,
+                            const SpearmanTailTable& tail_table) {
+  const int n = y_ranks.standardized_ranks.n_rows;
+  const arma::uword num_x_variables = x_ranks.standardized_ranks.n_cols;
+  const arma::uword num_y_variables = y_ranks.standardized_ranks.n_cols;
+  arma::vec min_pvalue(num_x_variables, fill::ones);
+  for (arma::uword j = 0; j < num_y_variables; ++j) {
+    const double* rho_col = rho.colptr(first_column + j);
+    for (arma::uword i = 0; i < num_x_variables; ++i) {
+      const bool ties = x_ranks.has_ties[i] | y_ranks.has_ties[j];
+      min_pvalue[i] =
+        std::min(computePvalueSpearmanRho(rho_col[i], n, ties, tail_table),
+                 min_pvalue[i]);
     }
   }
+  return min_pvalue;
+}
+
+// If no columns of x are kept, the column with the lowest minimum p-value is
+// kept by default
+arma::uvec selectFilteredColumns(const arma::vec& min_pvalue,
+                                 const arma::vec& min_pvalue_perm) {
   arma::uvec selected_x_columns = find(min_pvalue < min_pvalue_perm);
   if (selected_x_columns.size() == 0) {
     arma::uvec default_x_column(1);
-    default_x_column[1] = min_pvalue.index_min();
+    default_x_column[0] = min_pvalue.index_min();
     return default_x_column;
   } else {
     return selected_x_columns;
   }
+}
+
+} // namespace
+
+// NOTE: assumes 'y' and 'x' have the same number of rows
+// [[Rcpp::export]]
+arma::uvec applyAmkatFilter(const arma::mat& y,
+                            const arma::mat& x) {
+  const arma::uvec identity_row_order =
+    arma::regspace<arma::uvec>(0, y.n_rows - 1);
+  const arma::uvec reference_row_order =
+    generatePermutation(x.n_rows, drawPermutationSeed(),
+                        kFilterReferenceStream, 0);
+  // a single pass makes too few queries to repay building an AS 89 table
+  const SpearmanTailTable no_tail_table;
+  return applyAmkatFilterToRanks(computeRankCache(y), identity_row_order,
+                                 computeRankCache(x), reference_row_order,
+                                 no_tail_table);
+}
+
+// for each column of x: tests Spearman's Rho with each column of y (with its
+// rows in 'y_row_order'); if the minimum p-value is less than the value
+// obtained using a copy of x with its rows in 'x_reference_row_order', the
+// column is kept. If no columns of x are kept, the column with the lowest
+// minimum p-value is kept by default.
+// Permuting rows only relabels the cached ranks, so nothing is re-sorted, and
+// AS 89 tail areas come from 'tail_table' (built once per sample size).
+// Draws no random numbers
+arma::uvec applyAmkatFilterToRanks(const RankCache& y_ranks,
+                                   const arma::uvec& y_row_order,
+                                   const RankCache& x_ranks,
+                                   const arma::uvec& x_reference_row_order,
+                                   const SpearmanTailTable& tail_table) {
+  const int n = y_ranks.standardized_ranks.n_rows;
+  const arma::uword num_y_variables = y_ranks.standardized_ranks.n_cols;
+  // the reference copy of x is never formed: since
+  // sum_r x(order(r), i) * y(r, j) == sum_r x(r, i) * y(inverse(r), j), the
+  // y ranks are scattered by 'x_reference_row_order' instead, which is cheap
+  // when x has many more columns than y
+  arma::mat y_stacked_ranks(n, 2 * num_y_variables);
+  y_stacked_ranks.head_cols(num_y_variables) =
+    y_ranks.standardized_ranks.rows(y_row_order);
+  const arma::uvec reference_columns =
+    arma::regspace<arma::uvec>(num_y_variables, 2 * num_y_variables - 1);
+  y_stacked_ranks.submat(x_reference_row_order, reference_columns) =
+    y_stacked_ranks.head_cols(num_y_variables);
+  // entry (i, j) is Spearman's rho between column i of x and column j of y
+  // (first block) or between column i of the reference copy of x and column j
+  // of y (second block), all from a single BLAS product
+  const arma::mat rho_stacked =
+    clamp(x_ranks.standardized_ranks.t() * y_stacked_ranks, -1.0, 1.0);
+  return selectFilteredColumns(
+    computeMinPvalues(rho_stacked, 0, y_ranks, x_ranks, tail_table),
+    computeMinPvalues(rho_stacked, num_y_variables, y_ranks, x_ranks,
+                      tail_table));
+}
+
+// The part of applyAmkatFilterToRanks that depends only on the (unpermuted)
+// samples: the minimum p-value of each column of x against the columns of y.
+// When the filter is repeated with the same y and x and only the reference
+// copy of x redrawn, as for a mean observed statistic, this is computed once
+// and passed to applyAmkatFilterToReference
+arma::vec computeObservedFilterPvalues(const RankCache& y_ranks,
+                                       const RankCache& x_ranks,
+                                       const SpearmanTailTable& tail_table) {
+  const arma::mat rho = clamp(
+    x_ranks.standardized_ranks.t() * y_ranks.standardized_ranks, -1.0, 1.0);
+  return computeMinPvalues(rho, 0, y_ranks, x_ranks, tail_table);
+}
+
+// Same as applyAmkatFilterToRanks with y in its original row order, given
+// 'observed_min_pvalues' from computeObservedFilterPvalues, so that only the
+// reference half of the work (one n x p by n x q product) is done. Draws no
+// random numbers
+arma::uvec applyAmkatFilterToReference(const arma::vec& observed_min_pvalues,
+                                       const RankCache& y_ranks,
+                                       const RankCache& x_ranks,
+                                       const arma::uvec& x_reference_row_order,
+                                       const SpearmanTailTable& tail_table) {
+  arma::mat y_reference_ranks(arma::size(y_ranks.standardized_ranks));
+  y_reference_ranks.rows(x_reference_row_order) = y_ranks.standardized_ranks;
+  const arma::mat rho_reference = clamp(
+    x_ranks.standardized_ranks.t() * y_reference_ranks, -1.0, 1.0);
+  return selectFilteredColumns(
+    observed_min_pvalues,
+    computeMinPvalues(rho_reference, 0, y_ranks, x_ranks, tail_table));
 }
\ No newline at end of file
@@ -22,4 +22,23 @@
 
 arma::uvec applyAmkatFilter(const arma::mat& y, const arma::mat& x);
 
+#include "computeRankCache.h"
+#include "buildSpearmanTailTable.h"
+
+arma::uvec applyAmkatFilterToRanks(const RankCache& y_ranks,
+                                   const arma::uvec& y_row_order,
+                                   const RankCache& x_ranks,
+                                   const arma::uvec& x_reference_row_order,
+                                   const SpearmanTailTable& tail_table);
+
+arma::vec computeObservedFilterPvalues(const RankCache& y_ranks,
+                                       const RankCache& x_ranks,
+                                       const SpearmanTailTable& tail_table);
+
+arma::uvec applyAmkatFilterToReference(const arma::vec& observed_min_pvalues,
+                                       const RankCache& y_ranks,
+                                       const RankCache& x_ranks,
+                                       const arma::uvec& x_reference_row_order,
+                                       const SpearmanTailTable& tail_table);
+
 #endif /* AMKAT_SRC_APPLYAMKATFILTER_H_ */
\ No newline at end of file
@@ -0,0 +1,122 @@
+/* Builds a lookup table of AS 89 tail areas of Spearman's rho for one sample
+ size, so that repeated p-value computations do not re-evaluate the series
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include <algorithm>
+
+#include "getTailAreaSpearmanRho.h"
+#include "buildSpearmanTailTable.h"
+
+namespace {
+
+// AS 89 is only used for samples of up to this size (see
+// computePvalueSpearmanRho.cpp)
+const int kMaxAs89SampleSize = 1290;
+
+// AS 89 enumerates all n! permutations for samples of up to this size
+const int kMaxExactSampleSize = 9;
+
+// both tails together are capped at 16 MB, so only samples of up to 184
+// observations are tabulated. The table grows as n^3 / 3 entries (about 5.7
+// GB for n = 1290), so larger samples evaluate the AS 89 Edgeworth series at
+// each query instead; that series takes constant time, so the table saves
+// the most for small n, where AS 89 enumerates permutations
+const std::size_t kMaxTailTableEntries = 1 << 21;
+
+} // namespace
+
+// Returns an empty table unless some pair of columns of x and y is free of
+// ties (otherwise AS 89 is never used), 2 <= n <= 1290, the table fits under
+// the memory cap, and 'num_queries', the number of p-values the caller
+// expects to compute, is at least the number of entries. For n > 9 each
+// entry costs one evaluation of the series it replaces, so a table that is
+// queried fewer times than it has entries would cost more than it saves. The statistic S is always an even integer for
+// untied data, so only even arguments are tabulated; each entry is obtained
+// exactly as AS 89 would obtain it, so lookups are bit-identical to calling
+// getTailAreaSpearmanRho
+SpearmanTailTable buildSpearmanTailTable(int n,
+                                         const RankCache& y_ranks,
+                                         const RankCache& x_ranks,
+                                         double num_queries) {
+  SpearmanTailTable tail_table;
+  const bool has_tie_free_pair =
+    arma::any(x_ranks.has_ties == 0) && arma::any(y_ranks.has_ties == 0);
+  if (!has_tie_free_pair || (n < 2) || (n > kMaxAs89SampleSize)) {
+    return tail_table;
+  }
+  // S ranges over 0, 2, ..., (n^3 - n) / 3, and right-tailed queries add 2
+  const int max_statistic = n * (n * n - 1) / 3;
+  const std::size_t num_entries = max_statistic / 2 + 2;
+  if ((2 * num_entries > kMaxTailTableEntries) ||
+      ((n > kMaxExactSampleSize) && (num_queries < 2. * num_entries))) {
+    return tail_table;
+  }
+  tail_table.sample_size = n;
+  tail_table.upper_tail.resize(num_entries);
+  tail_table.lower_tail.resize(num_entries);
+
+  if (n <= kMaxExactSampleSize) {
+    // one pass over the permutations gives the null distribution of S;
+    // AS 89 would count the permutations with S >= q once per query
+    std::vector<int> num_permutations_at(num_entries, 0);
+    std::vector<int> ranks(n);
+    for (int i = 0; i < n; ++i) ranks[i] = i + 1;
+    int num_permutations = 0;
+    do {
+      int statistic = 0;
+      for (int i = 0; i < n; ++i) {
+        const int difference = i + 1 - ranks[i];
+        statistic += difference * difference;
+      }
+      ++num_permutations_at[statistic / 2];
+      ++num_permutations;
+    } while (std::next_permutation(ranks.begin(), ranks.end()));
+    int num_at_least = 0;
+    for (std::size_t k = num_entries; k-- > 0;) {
+      num_at_least += num_permutations_at[k];
+      const int q = 2 * k;
+      if ((q <= 0) || (q >= max_statistic)) {
+        // boundary cases are handled before the enumeration in AS 89
+        tail_table.upper_tail[k] = getTailAreaSpearmanRho(q, n, 0);
+        tail_table.lower_tail[k] = getTailAreaSpearmanRho(q, n, 1);
+      } else {
+        tail_table.upper_tail[k] = num_at_least / (double) num_permutations;
+        tail_table.lower_tail[k] =
+          (num_permutations - num_at_least) / (double) num_permutations;
+      }
+    }
+  } else {
+    for (std::size_t k = 0; k < num_entries; ++k) {
+      tail_table.upper_tail[k] = getTailAreaSpearmanRho(2. * k, n, 0);
+      tail_table.lower_tail[k] = getTailAreaSpearmanRho(2. * k, n, 1);
+    }
+  }
+  return tail_table;
+}
+
+// Each run tests every column of x against every column of y for both copies
+// of x (the observed copy is tested once for repeated observed filters, but
+// is counted every time); only tie-free pairs use AS 89, but all are counted
+double countFilterQueries(double num_y_columns,
+                          double num_x_columns,
+                          double num_filters) {
+  return 2 * num_y_columns * num_x_columns * num_filters;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+/* Builds a lookup table of AS 89 tail areas of Spearman's rho for one sample
+ size, so that repeated p-value computations do not re-evaluate the series
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_BUILDSPEARMANTAILTABLE_H_
+#define AMKAT_SRC_BUILDSPEARMANTAILTABLE_H_
+
+#include <vector>
+
+#include "computeRankCache.h"
+
+// Entry k of 'upper_tail' ('lower_tail') is the value getTailAreaSpearmanRho
+// returns for q = 2k and ltail = 0 (1) with n = 'sample_size'. A table with
+// 'sample_size' 0 is empty and every lookup falls back to the series; tables
+// are only built for n <= 184, and only when they save work (see
+// buildSpearmanTailTable.cpp)
+struct SpearmanTailTable {
+  int sample_size = 0;
+  std::vector<double> upper_tail;
+  std::vector<double> lower_tail;
+};
+
+SpearmanTailTable buildSpearmanTailTable(int n,
+                                         const RankCache& y_ranks,
+                                         const RankCache& x_ranks,
+                                         double num_queries);
+
+// Upper bound on the number of Spearman p-values computed by
+// 'num_filters' runs of the filter on 'num_y_columns' columns of y and
+// 'num_x_columns' columns of x
+double countFilterQueries(double num_y_columns,
+                          double num_x_columns,
+                          double num_filters);
+
+#endif /* AMKAT_SRC_BUILDSPEARMANTAILTABLE_H_ */
\ No newline at end of file
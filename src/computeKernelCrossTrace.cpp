@@ -0,0 +1,100 @@
+/* Computes trace(H * K0_a * H * K0_b) for two kernels, each held exactly or
+ through a low-rank factor
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "computeKernelCrossTrace.h"
+#include "multiplyKernelMatrix.h"
+#include "packKernelMoments.h"
+
+using namespace arma;
+
+// With A = H * K0_a * H and B = H * K0_b * H, returns trace(A * B), which is
+// trace_hk0hk0 when a and b are the same kernel. A low-rank kernel has
+// B = P * P' - H * E * H, with P its column-centered features and E the
+// diagonal matrix of 'centered_diagonal' (see computeLowRankKernelMoments.cpp)
+double computeKernelCrossTrace(const KernelMoments& moments_a,
+                               const KernelMoments& moments_b) {
+  const bool a_is_exact = moments_a.features.is_empty();
+  const bool b_is_exact = moments_b.features.is_empty();
+  if (a_is_exact && b_is_exact &&
+      (moments_a.kernel_matrix_diag0.is_empty() ||
+       moments_b.kernel_matrix_diag0.is_empty())) {
+    // packed storage: as below, from the upper triangles only; the diagonal
+    // of K0_b is zero, so the sum is twice that over i < j
+    const arma::uword n = moments_a.diag_hk0h.n_elem;
+    arma::vec row_sums(n, fill::zeros);
+    for (arma::uword j = 0; j < n; ++j) {
+      const arma::vec ker0_a_col = getKernelUpperColumn(moments_a, j);
+      row_sums.head(j) += ker0_a_col.head(j);
+      row_sums[j] += accu(ker0_a_col.head(j));
+    }
+    const arma::vec row_means = row_sums / n;
+    const double grand_mean = mean(row_means);
+    double trace = 0;
+    for (arma::uword j = 0; j < n; ++j) {
+      const arma::vec ker0_a_col = getKernelUpperColumn(moments_a, j);
+      const arma::vec ker0_b_col = getKernelUpperColumn(moments_b, j);
+      const double offset_j = grand_mean - row_means[j];
+      for (arma::uword i = 0; i < j; ++i) {
+        trace += (ker0_a_col[i] - row_means[i] + offset_j) * ker0_b_col[i];
+      }
+    }
+    return 2 * trace;
+  }
+  if (a_is_exact && b_is_exact) {
+    // trace(H * K0_a * H * K0_b) is the sum of the entries of
+    // (H * K0_a * H) % K0_b; see computeKernelMoments.cpp
+    const arma::mat& ker0_a = moments_a.kernel_matrix_diag0;
+    const arma::mat& ker0_b = moments_b.kernel_matrix_diag0;
+    const arma::rowvec column_means = mean(ker0_a, 0);
+    const double grand_mean = mean(column_means);
+    double trace = 0;
+    for (arma::uword j = 0; j < ker0_a.n_cols; ++j) {
+      const double offset_j = grand_mean - column_means[j];
+      const double* ker0_a_col = ker0_a.colptr(j);
+      const double* ker0_b_col = ker0_b.colptr(j);
+      for (arma::uword i = 0; i < ker0_a.n_rows; ++i) {
+        trace += (ker0_a_col[i] - column_means[i] + offset_j) * ker0_b_col[i];
+      }
+    }
+    return trace;
+  }
+  if (!a_is_exact && b_is_exact) {
+    return computeKernelCrossTrace(moments_b, moments_a);
+  }
+  const arma::mat centered_b =
+    moments_b.features.each_row() - mean(moments_b.features, 0);
+  const arma::vec& e_b = moments_b.centered_diagonal;
+  if (a_is_exact) {
+    // trace(A * P * P') - trace(A * H * E * H), with H * P = P
+    return accu(centered_b % multiplyKernelMatrix(moments_a, centered_b)) -
+      dot(e_b, moments_a.diag_hk0h);
+  }
+  const double n = centered_b.n_rows;
+  const arma::mat centered_a =
+    moments_a.features.each_row() - mean(moments_a.features, 0);
+  const arma::vec& e_a = moments_a.centered_diagonal;
+  return accu(square(centered_a.t() * centered_b)) -
+    dot(e_b, sum(square(centered_a), 1)) -
+    dot(e_a, sum(square(centered_b), 1)) +
+    dot(e_a, e_b) * (1 - 2 / n) + accu(e_a) * accu(e_b) / (n * n);
+}
\ No newline at end of file
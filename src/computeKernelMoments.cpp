@@ -0,0 +1,61 @@
+/* Computes the quantities of a kernel matrix that are needed by
+ estimateSignalToNoise but do not depend on the response variable
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+
+using namespace arma;
+
+// NOTE: assumes 'kernel_matrix' is square and symmetric. It is taken by value
+// so that a temporary is moved, not copied, into the stored K0.
+// The entries of H * K0 * H are K0(i, j) - m(i) - m(j) + m, where m(i) is the
+// mean of row (or column) i of K0 and m is the mean of all entries of K0, so
+// the traces are accumulated from these entries in O(n^2) time without forming
+// H or any other n x n product
+KernelMoments computeKernelMoments(arma::mat kernel_matrix) {
+  const arma::uword sample_size = kernel_matrix.n_rows;
+  KernelMoments moments;
+  moments.kernel_matrix_diag0 = std::move(kernel_matrix);
+  moments.kernel_matrix_diag0.diag().zeros();
+  const arma::mat& ker0 = moments.kernel_matrix_diag0;
+  const arma::rowvec column_means = mean(ker0, 0);
+  const double grand_mean = mean(column_means);
+  double trace_hk0h = 0;
+  double sum_squares_hk0h = 0;
+  double sum_squares_diag_hk0h = 0;
+  moments.diag_hk0h.set_size(sample_size);
+  for (arma::uword j = 0; j < sample_size; ++j) {
+    const double offset_j = grand_mean - column_means[j];
+    const double* ker0_col = ker0.colptr(j);
+    for (arma::uword i = 0; i < sample_size; ++i) {
+      const double hk0h_ij = ker0_col[i] - column_means[i] + offset_j;
+      sum_squares_hk0h += hk0h_ij * hk0h_ij;
+    }
+    const double hk0h_jj = ker0_col[j] - column_means[j] + offset_j;
+    moments.diag_hk0h[j] = hk0h_jj;
+    trace_hk0h += hk0h_jj;
+    sum_squares_diag_hk0h += hk0h_jj * hk0h_jj;
+  }
+  moments.trace_hk0 = trace_hk0h;             // trace(HK0) = trace(HK0H)
+  moments.trace_hk0hk0 = sum_squares_hk0h;    // HK0H is symmetric
+  moments.trace_hk0h_hadamard = sum_squares_diag_hk0h;
+  return moments;
+}
\ No newline at end of file
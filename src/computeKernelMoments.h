@@ -0,0 +1,49 @@
+/* Computes the quantities of a kernel matrix that are needed by
+ estimateSignalToNoise but do not depend on the response variable
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_COMPUTEKERNELMOMENTS_H_
+#define AMKAT_SRC_COMPUTEKERNELMOMENTS_H_
+
+// How an exact K0 is stored: as a full n x n matrix, or as its upper
+// triangle packed column by column (n * (n + 1) / 2 entries) in double or in
+// single precision; see packKernelMoments.cpp
+enum KernelStorage { kDenseStorage, kPackedStorage, kPackedFloatStorage };
+
+// K0 is the kernel matrix with its diagonal set to zero and H is the
+// centering matrix I - J / n. K0 is held either exactly or, when 'features'
+// is nonempty, through a low-rank factor of the uncentered kernel matrix (see
+// computeLowRankKernelMoments.cpp)
+struct KernelMoments {
+  arma::mat kernel_matrix_diag0;  // K0 (exact representation)
+  arma::vec packed_ker0;          // packed upper triangle of K0
+  arma::fvec packed_ker0_float;   // same, in single precision
+  arma::mat features;             // F, with K ~ F * F' (low-rank)
+  arma::vec row_sums_ker;         // row sums of F * F' with zero diagonal
+  double grand_sum_ker = 0;       // sum of 'row_sums_ker'
+  arma::vec centered_diagonal;    // diagonal removed from the centered kernel
+  double trace_hk0;               // trace(H * K0)
+  double trace_hk0hk0;            // trace(H * K0 * H * K0)
+  double trace_hk0h_hadamard;     // trace((H * K0 * H) % (H * K0 * H))
+  arma::vec diag_hk0h;            // diag(H * K0 * H)
+};
+
+KernelMoments computeKernelMoments(arma::mat kernel_matrix);
+
+#endif /* AMKAT_SRC_COMPUTEKERNELMOMENTS_H_ */
\ No newline at end of file
@@ -0,0 +1,186 @@
+/* Maintains the pairwise sums over the selected columns of x from which the
+ n x n kernel matrices are evaluated, updating them as columns are added to or
+ removed from the selection
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelSums.h"
+#include "computeSquaredDistances.h"
+#include "generateIbsKernelPacked.h"
+#include "packGenotypes.h"
+
+namespace {
+
+struct KernelSumTerms {
+  bool gram = false;
+  bool squared_distances = false;
+  bool squared_norms = false;
+  bool manhattan_distances = false;
+};
+
+KernelSumTerms getKernelSumTerms(
+    const std::vector<std::string>& kernel_functions) {
+  KernelSumTerms terms;
+  for (const std::string& kernel_function : kernel_functions) {
+    terms.gram |= (kernel_function == "lin") || (kernel_function == "quad");
+    terms.squared_distances |=
+      (kernel_function == "gau") || (kernel_function == "exp");
+    terms.squared_norms |= (kernel_function == "exp");
+    terms.manhattan_distances |= (kernel_function == "IBS");
+  }
+  return terms;
+}
+
+bool hasKernelSumTerms(const KernelSums& kernel_sums,
+                       const KernelSumTerms& terms) {
+  return (terms.gram == !kernel_sums.gram.is_empty()) &&
+    (terms.squared_distances == !kernel_sums.squared_distances.is_empty()) &&
+    (terms.squared_norms == !kernel_sums.squared_norms.is_empty()) &&
+    (terms.manhattan_distances ==
+      !kernel_sums.manhattan_distances.is_empty());
+}
+
+arma::mat computeManhattanDistances(const arma::mat& x) {
+  // genotype data (all entries 0, 1 or 2) is packed to 2 bits per call and
+  // compared with XOR and popcount; any other data uses the generic loop
+  if (isGenotypeMatrix(x)) {
+    return computeManhattanDistancesPacked(packGenotypes(x));
+  }
+  const arma::uword sample_size = x.n_rows;
+  arma::mat manhattan_distances(sample_size, sample_size, arma::fill::zeros);
+  for (arma::uword j = 0; j < sample_size; ++j) {
+    const arma::rowvec x1 = x.row(j);
+    for (arma::uword i = 0; i < (j + 1); ++i) { // upper triangle
+      manhattan_distances(i, j) = arma::accu(arma::abs(x1 - x.row(i)));
+    }
+  }
+  return arma::symmatu(manhattan_distances); //reflect upper to lower
+}
+
+KernelSums sumOverColumns(const arma::mat& x, const KernelSumTerms& terms) {
+  KernelSums kernel_sums;
+  if (terms.gram) kernel_sums.gram = x * x.t();
+  if (terms.squared_distances) {
+    kernel_sums.squared_distances = computeSquaredDistances(x);
+  }
+  if (terms.squared_norms) {
+    kernel_sums.squared_norms = arma::sum(arma::square(x), 1);
+  }
+  if (terms.manhattan_distances) {
+    kernel_sums.manhattan_distances = computeManhattanDistances(x);
+  }
+  return kernel_sums;
+}
+
+// adds (sign = 1) or subtracts (sign = -1) the sums of 'delta'
+void addKernelSums(KernelSums& kernel_sums,
+                   const KernelSums& delta,
+                   double sign) {
+  if (!delta.gram.is_empty()) kernel_sums.gram += sign * delta.gram;
+  if (!delta.squared_distances.is_empty()) {
+    kernel_sums.squared_distances += sign * delta.squared_distances;
+  }
+  if (!delta.squared_norms.is_empty()) {
+    kernel_sums.squared_norms += sign * delta.squared_norms;
+  }
+  if (!delta.manhattan_distances.is_empty()) {
+    kernel_sums.manhattan_distances += sign * delta.manhattan_distances;
+  }
+}
+
+} // namespace
+
+// Sums over all columns of 'x'; 'kernel_functions' takes the values accepted
+// by generateKernelMatrix
+KernelSums computeKernelSums(const arma::mat& x,
+                             const std::vector<std::string>& kernel_functions) {
+  KernelSums kernel_sums =
+    sumOverColumns(x, getKernelSumTerms(kernel_functions));
+  // n_cols - 1 would wrap around for an x with no columns
+  if (x.n_cols > 0) {
+    kernel_sums.columns = arma::regspace<arma::uvec>(0, x.n_cols - 1);
+  }
+  return kernel_sums;
+}
+
+// Brings 'kernel_sums' to the columns 'selected_x_columns' of 'x' (in
+// increasing order, as returned by the filter). Each sum is additive over
+// columns, so the columns that entered or left the selection since the last
+// call are added or subtracted, at the cost of forming the sums of those
+// columns only (an O(n^2) BLAS product per changed column). The sums are
+// rebuilt instead when that is no cheaper, when they hold different terms
+// than 'kernel_functions' needs, or after kKernelUpdateChunkSize updates.
+// Subtracting columns can leave small negative distances from rounding; these
+// are clamped to zero
+void updateKernelSums(KernelSums& kernel_sums,
+                      const arma::mat& x,
+                      const arma::uvec& selected_x_columns,
+                      const std::vector<std::string>& kernel_functions) {
+  const KernelSumTerms terms = getKernelSumTerms(kernel_functions);
+  // columns in the new selection only, and in the old selection only
+  std::vector<arma::uword> added_columns;
+  std::vector<arma::uword> removed_columns;
+  const arma::uvec& old_columns = kernel_sums.columns;
+  arma::uword a = 0;
+  arma::uword b = 0;
+  while ((a < selected_x_columns.n_elem) || (b < old_columns.n_elem)) {
+    if ((b == old_columns.n_elem) ||
+        ((a < selected_x_columns.n_elem) &&
+         (selected_x_columns[a] < old_columns[b]))) {
+      added_columns.push_back(selected_x_columns[a++]);
+    } else if ((a == selected_x_columns.n_elem) ||
+               (old_columns[b] < selected_x_columns[a])) {
+      removed_columns.push_back(old_columns[b++]);
+    } else {
+      ++a;
+      ++b;
+    }
+  }
+  const std::size_t num_changes =
+    added_columns.size() + removed_columns.size();
+  if (num_changes == 0 && hasKernelSumTerms(kernel_sums, terms)) return;
+  if (old_columns.is_empty() || !hasKernelSumTerms(kernel_sums, terms) ||
+      (num_changes >= selected_x_columns.n_elem) ||
+      (kernel_sums.num_updates >= kKernelUpdateChunkSize)) {
+    kernel_sums = sumOverColumns(x.cols(selected_x_columns), terms);
+    kernel_sums.columns = selected_x_columns;
+    return;
+  }
+  if (!added_columns.empty()) {
+    addKernelSums(kernel_sums,
+                  sumOverColumns(x.cols(arma::uvec(added_columns)), terms),
+                  1);
+  }
+  if (!removed_columns.empty()) {
+    addKernelSums(kernel_sums,
+                  sumOverColumns(x.cols(arma::uvec(removed_columns)), terms),
+                  -1);
+    if (terms.squared_distances) {
+      kernel_sums.squared_distances.clamp(0, arma::datum::inf);
+      kernel_sums.squared_distances.diag().zeros();
+    }
+    if (terms.manhattan_distances) {
+      kernel_sums.manhattan_distances.clamp(0, arma::datum::inf);
+      kernel_sums.manhattan_distances.diag().zeros();
+    }
+  }
+  kernel_sums.columns = selected_x_columns;
+  ++kernel_sums.num_updates;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+/* Maintains the pairwise sums over the selected columns of x from which the
+ n x n kernel matrices are evaluated, updating them as columns are added to or
+ removed from the selection
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_COMPUTEKERNELSUMS_H_
+#define AMKAT_SRC_COMPUTEKERNELSUMS_H_
+
+#include <string>
+#include <vector>
+
+// Sums over the selected columns c of x; each kernel of
+// generateKernelMatrixFromSums is an entrywise function of these and of the
+// number of columns. Only the sums needed by the kernels at hand are formed;
+// the others are empty. The drivers keep one KernelSums per thread for
+// incremental updates, i.e. up to three n x n matrices per thread on top of
+// the kernels themselves
+struct KernelSums {
+  arma::uvec columns;             // the selected columns, in increasing order
+  arma::mat gram;                 // sum_c x(i, c) * x(j, c)       (lin, quad)
+  arma::mat squared_distances;    // sum_c (x(i, c) - x(j, c))^2   (gau, exp)
+  arma::vec squared_norms;        // sum_c x(i, c)^2               (exp)
+  arma::mat manhattan_distances;  // sum_c |x(i, c) - x(j, c)|     (IBS)
+  int num_updates = 0;            // incremental updates since the last rebuild
+};
+
+// Rounding errors accumulate over incremental updates, so the sums are rebuilt
+// after this many. The drivers also start each run of this many consecutive
+// permutations from a rebuild, so that statistic k depends only on k and not
+// on which permutations the same thread handled before it
+const int kKernelUpdateChunkSize = 16;
+
+KernelSums computeKernelSums(const arma::mat& x,
+                             const std::vector<std::string>& kernel_functions);
+
+void updateKernelSums(KernelSums& kernel_sums,
+                      const arma::mat& x,
+                      const arma::uvec& selected_x_columns,
+                      const std::vector<std::string>& kernel_functions);
+
+#endif /* AMKAT_SRC_COMPUTEKERNELSUMS_H_ */
\ No newline at end of file
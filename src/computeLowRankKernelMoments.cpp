@@ -0,0 +1,74 @@
+/* Computes the quantities needed by estimateSignalToNoise from a low-rank
+ factor of the (uncentered) kernel matrix, without forming any n x n matrix
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "computeLowRankKernelMoments.h"
+
+using namespace arma;
+
+// With K = F * F' (F = 'features', n x m), d = diag(K), r the row sums of K
+// with zero diagonal and S their total, the centered kernel of
+// generateKernelMatrix is K - (r * 1' + 1 * r' - S * J / n) / (n - 1), and K0
+// is that with its diagonal e removed. H annihilates the rank-one terms, so
+// H * K0 * H = P * P' - H * E * H with P = H * F and E = diag(e), and
+//   trace(H * K0)           = ||P||^2 - sum(e) * (1 - 1 / n)
+//   trace(H * K0 * H * K0)  = ||P' * P||^2 - 2 * sum_i e_i * ||p_i||^2
+//                             + sum(e^2) * (1 - 2 / n) + sum(e)^2 / n^2
+//   diag(H * K0 * H)_i      = ||p_i||^2 - e_i * (1 - 2 / n) - sum(e) / n^2
+// all in O(n * m^2) time and O(n * m) memory
+KernelMoments computeLowRankKernelMoments(const arma::mat& features) {
+  const double n = features.n_rows;
+  KernelMoments moments;
+  moments.features = features;
+  const arma::vec diagonal = sum(square(features), 1);
+  const arma::vec feature_sums = sum(features, 0).t();
+  moments.row_sums_ker = features * feature_sums - diagonal;
+  moments.grand_sum_ker = dot(feature_sums, feature_sums) - accu(diagonal);
+  moments.centered_diagonal = diagonal -
+    (2 * moments.row_sums_ker - moments.grand_sum_ker / n) / (n - 1);
+  const arma::vec& e = moments.centered_diagonal;
+  const double sum_e = accu(e);
+
+  const arma::mat centered_features =
+    features.each_row() - mean(features, 0);
+  const arma::vec squared_norms = sum(square(centered_features), 1);
+  const arma::mat gram = centered_features.t() * centered_features;
+  moments.trace_hk0 = accu(squared_norms) - sum_e * (1 - 1 / n);
+  moments.trace_hk0hk0 = accu(square(gram)) - 2 * dot(e, squared_norms) +
+    dot(e, e) * (1 - 2 / n) + sum_e * sum_e / (n * n);
+  moments.diag_hk0h = squared_norms - e * (1 - 2 / n) - sum_e / (n * n);
+  moments.trace_hk0h_hadamard = dot(moments.diag_hk0h, moments.diag_hk0h);
+  return moments;
+}
+
+// y' * K0 * y for each column y of 'y' and the low-rank representation, in
+// O(n * m) time per column
+arma::rowvec computeLowRankQuadraticForms(const arma::mat& y,
+                                          const KernelMoments& kernel_moments) {
+  const double n = y.n_rows;
+  const arma::rowvec y_sums = sum(y, 0);
+  const arma::mat projections = kernel_moments.features.t() * y;
+  return sum(square(projections), 0) -
+    2 * (kernel_moments.row_sums_ker.t() * y) % y_sums / (n - 1) +
+    kernel_moments.grand_sum_ker * square(y_sums) / (n * (n - 1)) -
+    kernel_moments.centered_diagonal.t() * square(y);
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+/* Computes the quantities needed by estimateSignalToNoise from a low-rank
+ factor of the (uncentered) kernel matrix, without forming any n x n matrix
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_COMPUTELOWRANKKERNELMOMENTS_H_
+#define AMKAT_SRC_COMPUTELOWRANKKERNELMOMENTS_H_
+
+#include "computeKernelMoments.h"
+
+KernelMoments computeLowRankKernelMoments(const arma::mat& features);
+
+arma::rowvec computeLowRankQuadraticForms(const arma::mat& y,
+                                          const KernelMoments& kernel_moments);
+
+#endif /* AMKAT_SRC_COMPUTELOWRANKKERNELMOMENTS_H_ */
\ No newline at end of file
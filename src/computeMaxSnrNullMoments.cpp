@@ -0,0 +1,188 @@
+/* Approximates the mean and variance of the AMKAT statistic (without the
+ filter) under the permutation null distribution
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include <cmath>
+
+#include "computeKernelCrossTrace.h"
+#include "computeKernelMoments.h"
+#include "computeSnrVariance.h"
+#include "computeMaxSnrNullMoments.h"
+
+using namespace arma;
+
+// Returns (mean, variance) of the statistic sum_i max_j Z_ij, where
+// Z_ij = y_i' * K0_j * y_i / (y_variances[i] * sqrt(V_ij)) is the standardized
+// signal-to-noise ratio of column i of 'y' for kernel j and V_ij its variance
+// from computeSnrVariance; 'y' is assumed centered.
+// The means and covariances of the Z_ij under permutation of the rows of y
+// are exact: with u and v standardized columns of y, A = H * K0_j * H and
+// B = H * K0_k * H (so that u' * K0_j * u = u' * A * u), they follow from the
+// permutation moments of products of entries of u and v and depend on A and B
+// only through trace(A), trace(B), trace(A * B) and diag(A)' * diag(B).
+// Taking the Z_ij as jointly normal, each maximum over kernels is then
+// approximated by pairwise reduction with the moment formulas of Clark (1961),
+// which also give the covariance of each maximum with the remaining variables
+arma::vec computeMaxSnrNullMoments(
+    const arma::mat& y,
+    const arma::vec& y_variances,
+    const std::vector<KernelMoments>& kernel_moments) {
+  const int n = y.n_rows;
+  const uword num_y_variables = y.n_cols;
+  const uword num_kernels = kernel_moments.size();
+
+  mat cross_traces(num_kernels, num_kernels);
+  mat cross_diagonals(num_kernels, num_kernels);
+  vec traces(num_kernels);
+  for (uword j = 0; j < num_kernels; ++j) {
+    traces[j] = kernel_moments[j].trace_hk0;
+    for (uword k = 0; k <= j; ++k) {
+      cross_traces(j, k) = (j == k) ? kernel_moments[j].trace_hk0hk0 :
+        computeKernelCrossTrace(kernel_moments[j], kernel_moments[k]);
+      cross_traces(k, j) = cross_traces(j, k);
+      cross_diagonals(j, k) =
+        dot(kernel_moments[j].diag_hk0h, kernel_moments[k].diag_hk0h);
+      cross_diagonals(k, j) = cross_diagonals(j, k);
+    }
+  }
+
+  // power sums of the standardized columns: sum(u % v) and sum(u^2 % v^2)
+  mat y_standardized(y);
+  for (uword i = 0; i < num_y_variables; ++i) {
+    y_standardized.col(i) /= sqrt(y_variances[i]);
+  }
+  const mat cross_products = y_standardized.t() * y_standardized;
+  const mat y_squared = square(y_standardized);
+  const mat cross_squares = y_squared.t() * y_squared;
+
+  const double n_1 = n;
+  const double n_2 = n_1 * (n - 1);
+  const double n_3 = n_2 * (n - 2);
+  const double n_4 = n_3 * (n - 3);
+  // variables are indexed by i * num_kernels + j
+  const uword num_variables = num_y_variables * num_kernels;
+  vec means(num_variables);
+  vec standard_deviations(num_variables);
+  mat covariances(num_variables, num_variables);
+  for (uword i = 0; i < num_y_variables; ++i) {
+    const double fourth_moment =
+      mean(pow(y_standardized.col(i), 4)) - 3;
+    for (uword j = 0; j < num_kernels; ++j) {
+      const uword row = i * num_kernels + j;
+      standard_deviations[row] =
+        sqrt(computeSnrVariance(n, kernel_moments[j], fourth_moment));
+      means[row] = traces[j] * cross_products(i, i) / (n - 1);
+    }
+  }
+  for (uword i = 0; i < num_y_variables; ++i) {
+    for (uword l = 0; l < num_y_variables; ++l) {
+      const double sum_squares_product = cross_products(i, i) *
+        cross_products(l, l);
+      const double products_squared = cross_products(i, l) *
+        cross_products(i, l);
+      const double squares_sum = cross_squares(i, l);
+      for (uword j = 0; j < num_kernels; ++j) {
+        for (uword k = 0; k < num_kernels; ++k) {
+          // A and B split into diagonal and off-diagonal parts; the row sums
+          // of A and B are zero
+          const double trace_product = traces[j] * traces[k];
+          const double diagonal_product = cross_diagonals(j, k);
+          const double off_diagonal_product =
+            cross_traces(j, k) - diagonal_product;
+          const double paths_of_length_two =
+            diagonal_product - off_diagonal_product;
+          const double disjoint_pairs = trace_product -
+            2 * off_diagonal_product - 4 * paths_of_length_two;
+          const double off_off =
+            2 * off_diagonal_product * (products_squared - squares_sum) / n_2 +
+            4 * paths_of_length_two * (2 * squares_sum - products_squared) /
+              n_3 +
+            disjoint_pairs * (sum_squares_product + 2 * products_squared -
+                              6 * squares_sum) / n_4;
+          const double diagonal_diagonal =
+            diagonal_product * squares_sum / n_1 +
+            (trace_product - diagonal_product) *
+              (sum_squares_product - squares_sum) / n_2;
+          const double diagonal_off =
+            2 * diagonal_product * squares_sum / n_2 +
+            (2 * diagonal_product - trace_product) *
+              (2 * squares_sum - sum_squares_product) / n_3;
+          const uword row = i * num_kernels + j;
+          const uword column = l * num_kernels + k;
+          covariances(row, column) =
+            diagonal_diagonal + 2 * diagonal_off + off_off -
+            means[row] * means[column];
+        }
+      }
+    }
+  }
+  means /= standard_deviations;
+  covariances.each_col() /= standard_deviations;
+  covariances.each_row() /= standard_deviations.t();
+
+  // Clark's approximation: the running maximum for column i is kept in the
+  // slot of kernel 0 and each further kernel is folded into it
+  for (uword i = 0; i < num_y_variables; ++i) {
+    const uword running = i * num_kernels;
+    for (uword j = 1; j < num_kernels; ++j) {
+      const uword other = running + j;
+      const double variance_1 = covariances(running, running);
+      const double variance_2 = covariances(other, other);
+      const double spread = std::sqrt(std::max(
+        variance_1 + variance_2 - 2 * covariances(running, other), 0.0));
+      double weight_1;
+      double max_mean;
+      double max_second_moment;
+      if (spread <= 1e-12 * std::sqrt(variance_1 + variance_2)) {
+        // (numerically) identical variables up to their means
+        weight_1 = (means[running] >= means[other]) ? 1 : 0;
+        max_mean = std::max(means[running], means[other]);
+        max_second_moment = weight_1 * (means[running] * means[running] +
+          variance_1) + (1 - weight_1) * (means[other] * means[other] +
+          variance_2);
+      } else {
+        const double alpha = (means[running] - means[other]) / spread;
+        weight_1 = 0.5 * std::erfc(-alpha / std::sqrt(2.0));
+        const double weight_2 = 0.5 * std::erfc(alpha / std::sqrt(2.0));
+        const double density =
+          std::exp(-0.5 * alpha * alpha) / std::sqrt(2 * datum::pi);
+        max_mean = means[running] * weight_1 + means[other] * weight_2 +
+          spread * density;
+        max_second_moment =
+          (means[running] * means[running] + variance_1) * weight_1 +
+          (means[other] * means[other] + variance_2) * weight_2 +
+          (means[running] + means[other]) * spread * density;
+      }
+      const vec max_covariances = weight_1 * covariances.col(running) +
+        (1 - weight_1) * covariances.col(other);
+      covariances.col(running) = max_covariances;
+      covariances.row(running) = max_covariances.t();
+      covariances(running, running) =
+        std::max(max_second_moment - max_mean * max_mean, 0.0);
+      means[running] = max_mean;
+    }
+  }
+  const uvec maxima = regspace<uvec>(0, num_kernels, num_variables - 1);
+  vec null_moments(2);
+  null_moments[0] = accu(means.elem(maxima));
+  null_moments[1] = accu(covariances.submat(maxima, maxima));
+  return null_moments;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+/* Computes the AMKAT statistic (the sum over the columns of y of the largest
+ standardized signal-to-noise ratio across the candidate kernels)
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "estimateSignalToNoise.h"
+#include "computeMaxSnrStatistic.h"
+
+// 'kernel_moments' holds one entry per candidate kernel; the columns of 'y'
+// are evaluated together against each kernel
+double computeMaxSnrStatistic(const arma::mat& y,
+                              const arma::vec& y_variances,
+                              const std::vector<KernelMoments>& kernel_moments) {
+  arma::rowvec max_snr(y.n_cols);
+  max_snr.fill(-arma::datum::inf);
+  for (std::size_t j = 0; j < kernel_moments.size(); ++j) {
+    max_snr = arma::max(max_snr, estimateSignalToNoiseColumns(
+      y, y_variances, kernel_moments[j]));
+  }
+  double statistic = 0;
+  for (arma::uword i = 0; i < y.n_cols; ++i) {
+    statistic += max_snr[i];
+  }
+  return statistic;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+/* Computes mid-ranks (ties receive the average of their ranks) and a tie
+ indicator from a single sort of the values
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "computeMidRanks.h"
+
+namespace {
+
+const uint64_t kSignBit = 0x8000000000000000ULL;
+
+// below this length a comparison sort beats the eight radix passes
+const arma::uword kRadixSortMinLength = 512;
+
+// maps a double to an unsigned integer with the same ordering; -0.0 is mapped
+// to the key of 0.0 so that values which compare equal get equal keys.
+// NaN is not supported
+inline uint64_t toSortableKey(double value) {
+  value += 0.0;
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & kSignBit) ? ~bits : (bits | kSignBit);
+}
+
+// least-significant-digit radix sort of 'keys' (carrying 'order' along) with
+// 8-bit digits; passes where every key has the same digit are skipped
+void radixSortKeys(arma::uword num_values, RankWorkspace& workspace) {
+  for (int shift = 0; shift < 64; shift += 8) {
+    arma::uword counts[256] = {0};
+    for (arma::uword i = 0; i < num_values; ++i) {
+      ++counts[(workspace.keys[i] >> shift) & 0xFF];
+    }
+    if (counts[(workspace.keys[0] >> shift) & 0xFF] == num_values) continue;
+    arma::uword offset = 0;
+    for (int digit = 0; digit < 256; ++digit) {
+      const arma::uword count = counts[digit];
+      counts[digit] = offset;
+      offset += count;
+    }
+    for (arma::uword i = 0; i < num_values; ++i) {
+      const arma::uword position =
+        counts[(workspace.keys[i] >> shift) & 0xFF]++;
+      workspace.keys_buffer[position] = workspace.keys[i];
+      workspace.order_buffer[position] = workspace.order[i];
+    }
+    workspace.keys.swap(workspace.keys_buffer);
+    workspace.order.swap(workspace.order_buffer);
+  }
+}
+
+} // namespace
+
+// Writes the mid-rank of each of the 'num_values' entries of 'values' to
+// 'ranks' (1-based, as in R's rank()) and returns whether any values are tied.
+// Allocates nothing once 'workspace' has grown to 'num_values'
+bool computeMidRanks(const double* values,
+                     arma::uword num_values,
+                     double* ranks,
+                     RankWorkspace& workspace) {
+  if (num_values == 0) return false;
+  if (workspace.keys.size() < num_values) {
+    workspace.keys.resize(num_values);
+    workspace.keys_buffer.resize(num_values);
+    workspace.order.resize(num_values);
+    workspace.order_buffer.resize(num_values);
+  }
+  for (arma::uword i = 0; i < num_values; ++i) {
+    workspace.keys[i] = toSortableKey(values[i]);
+    workspace.order[i] = i;
+  }
+  if (num_values >= kRadixSortMinLength) {
+    radixSortKeys(num_values, workspace);
+  } else {
+    // sort the indices, then gather the keys in sorted order
+    const std::vector<uint64_t>& keys = workspace.keys;
+    std::sort(workspace.order.begin(), workspace.order.begin() + num_values,
+              [&keys](arma::uword a, arma::uword b) {
+                return keys[a] < keys[b];
+              });
+    for (arma::uword i = 0; i < num_values; ++i) {
+      workspace.keys_buffer[i] = keys[workspace.order[i]];
+    }
+    workspace.keys.swap(workspace.keys_buffer);
+  }
+
+  // walk runs of equal keys (equal keys <=> equal values)
+  bool has_ties = false;
+  arma::uword j = 0;
+  for (arma::uword i = 0; i < num_values; i = j + 1) {
+    j = i;
+    while ((j + 1 < num_values) &&
+           (workspace.keys[j] == workspace.keys[j + 1])) {
+      ++j;
+    }
+    if (j > i) has_ties = true;
+    const double mid_rank = (i + j + 2) / 2.; // averaging ties
+    for (arma::uword k = i; k <= j; ++k) {
+      ranks[workspace.order[k]] = mid_rank;
+    }
+  }
+  return has_ties;
+}
\ No newline at end of file
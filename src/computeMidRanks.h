@@ -0,0 +1,42 @@
+/* Computes mid-ranks (ties receive the average of their ranks) and a tie
+ indicator from a single sort of the values
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_COMPUTEMIDRANKS_H_
+#define AMKAT_SRC_COMPUTEMIDRANKS_H_
+
+#include <cstdint>
+#include <vector>
+
+// Scratch space for computeMidRanks; buffers grow to the largest length seen
+// and are then reused, so ranking many columns of the same length allocates
+// only once. One workspace per thread
+struct RankWorkspace {
+  std::vector<uint64_t> keys;
+  std::vector<uint64_t> keys_buffer;
+  std::vector<arma::uword> order;
+  std::vector<arma::uword> order_buffer;
+};
+
+bool computeMidRanks(const double* values,
+                     arma::uword num_values,
+                     double* ranks,
+                     RankWorkspace& workspace);
+
+#endif /* AMKAT_SRC_COMPUTEMIDRANKS_H_ */
\ No newline at end of file
@@ -0,0 +1,50 @@
+/* Computes the p-value for a two-tailed test of H_0: Spearman's Rho = 0
+ from the sample correlation of the ranks
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "lookupTailAreaSpearmanRho.h"
+#include "computePvalueSpearmanRho.h"
+
+// The implementation is based on the one found in
+// r-source/src/library/stats/R/cor.test.R
+// 'ties' indicates whether either sample contains tied values; AS 89 tail
+// areas are read from 'tail_table' when it covers them
+double computePvalueSpearmanRho(double rho_spearman,
+                                int n,
+                                bool ties,
+                                const SpearmanTailTable& tail_table) {
+  const int left_tailed = (rho_spearman > 0);
+  double tail_area = 1;
+  if ((n <= 1290) & !ties) {
+    // using algorithm AS 89
+    const double q = (n * (n * n - 1)) * (1 - rho_spearman) / 6;
+    tail_area = lookupTailAreaSpearmanRho(round(q) + (2 * left_tailed),
+                                          n, left_tailed, tail_table);
+  } else {
+    // using Student's t
+    // Rf_pt calls pt() in R, but is missing the ncp argument;
+    // thus args are Rf_pt(quantile, df, lower.tail, log.p)
+    tail_area =
+      Rf_pt(rho_spearman / sqrt((1 - rho_spearman * rho_spearman) / (n - 2)),
+            n - 2, !left_tailed, 0);
+  }
+  return (std::min(1.0, 2 * tail_area));
+}
\ No newline at end of file
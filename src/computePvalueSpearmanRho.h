@@ -0,0 +1,31 @@
+/* Computes the p-value for a two-tailed test of H_0: Spearman's Rho = 0
+ from the sample correlation of the ranks
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_COMPUTEPVALUESPEARMANRHO_H_
+#define AMKAT_SRC_COMPUTEPVALUESPEARMANRHO_H_
+
+#include "buildSpearmanTailTable.h"
+
+double computePvalueSpearmanRho(double rho_spearman,
+                                int n,
+                                bool ties,
+                                const SpearmanTailTable& tail_table);
+
+#endif /* AMKAT_SRC_COMPUTEPVALUESPEARMANRHO_H_ */
\ No newline at end of file
@@ -0,0 +1,53 @@
+/* Computes the standardized sample ranks and tie indicators for every column
+ of a matrix, for reuse across permutations of its rows
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeMidRanks.h"
+#include "computeRankCache.h"
+
+// Ranks every column with one sort each, reusing a single workspace and
+// writing straight into the cache
+RankCache computeRankCache(const arma::mat& data) {
+  const arma::uword sample_size = data.n_rows;
+  RankCache cache;
+  cache.standardized_ranks.set_size(sample_size, data.n_cols);
+  cache.has_ties.set_size(data.n_cols);
+  RankWorkspace workspace;
+  for (arma::uword j = 0; j < data.n_cols; ++j) {
+    double* ranks = cache.standardized_ranks.colptr(j);
+    cache.has_ties[j] =
+      computeMidRanks(data.colptr(j), sample_size, ranks, workspace);
+    // the mean of the ranks 1, ..., n is (n + 1) / 2 regardless of ties
+    const double mean_rank = (sample_size + 1) / 2.;
+    double sum_squares = 0;
+    for (arma::uword i = 0; i < sample_size; ++i) {
+      ranks[i] -= mean_rank;
+      sum_squares += ranks[i] * ranks[i];
+    }
+    // a constant column keeps zero ranks, so its rho is 0 rather than NaN;
+    // either way its Spearman p-value is 1
+    if (sum_squares > 0) {
+      const double inverse_norm = 1 / std::sqrt(sum_squares);
+      for (arma::uword i = 0; i < sample_size; ++i) ranks[i] *= inverse_norm;
+    }
+  }
+  return cache;
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+/* Computes the standardized sample ranks and tie indicators for every column
+ of a matrix, for reuse across permutations of its rows
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_COMPUTERANKCACHE_H_
+#define AMKAT_SRC_COMPUTERANKCACHE_H_
+
+// Column j of 'standardized_ranks' holds the sample ranks of column j of the
+// data, centered and scaled to unit Euclidean norm (all zeros if the column is
+// constant), so the Spearman correlation of two columns is the dot product of
+// their standardized ranks. Permuting the rows of the data permutes the rows
+// of 'standardized_ranks' and leaves 'has_ties' unchanged
+struct RankCache {
+  arma::mat standardized_ranks;
+  arma::uvec has_ties;
+};
+
+RankCache computeRankCache(const arma::mat& data);
+
+#endif /* AMKAT_SRC_COMPUTERANKCACHE_H_ */
\ No newline at end of file
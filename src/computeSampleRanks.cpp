@@ -19,27 +19,15 @@
 
 #include <RcppArmadillo.h>
 
+#include "computeMidRanks.h"
+#include "computeSampleRanks.h"
+
 using namespace arma;
 
 // [[Rcpp::export]]
 arma::vec computeSampleRanks(const arma::vec& x) {
-  const arma::uword sample_size = x.size();
-  const int n(sample_size);
-  const arma::vec x_sorted = arma::sort(x);
-  const arma::uvec x_sorted_indices = arma::sort_index(x);
-  arma::vec x_ranks(n);
-  arma::uword j = 0;
-  for (arma::uword i = 0; i < sample_size; i = j + 1) {
-    
-    // how many values are tied with x_sorted[i]?
-    j = i;
-    while ((j < sample_size - 1) & (x_sorted[j] == x_sorted[j + 1])) { 
-      j++; 
-    }
-    
-    for (arma::uword k = i; k <= j; k++) {
-      x_ranks[x_sorted_indices[k]] = (i + j + 2) / 2.; // averaging ties
-    }
-  }
+  arma::vec x_ranks(x.n_elem);
+  RankWorkspace workspace;
+  computeMidRanks(x.memptr(), x.n_elem, x_ranks.memptr(), workspace);
   return x_ranks;
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+/* Computes the variance term used to standardize the signal-to-noise ratio
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "computeSnrVariance.h"
+#include "doubleDouble.h"
+
+// The inputs are doubles, so the only rounding that matters is in combining
+// them; the terms of the formula can nearly cancel, so it is evaluated in
+// double-double arithmetic, which agrees with the former 100-digit MPFR
+// evaluation to double precision (see validateSnrVariance.cpp)
+double computeSnrVariance(int n,
+                          const KernelMoments& kernel_moments,
+                          double fourth_moment) {
+  const DoubleDouble trace_hk0hk0 =
+    makeDoubleDouble(kernel_moments.trace_hk0hk0);
+  const DoubleDouble trace_hk0h_hadamard =
+    makeDoubleDouble(kernel_moments.trace_hk0h_hadamard);
+  const DoubleDouble squared_trace_hk0 =
+    twoProd(kernel_moments.trace_hk0, kernel_moments.trace_hk0);
+  const DoubleDouble kurtosis_term = makeDoubleDouble(fourth_moment);
+  const DoubleDouble one_over_n = ddDivide(makeDoubleDouble(1), n);
+
+  // (2 - 12 / (n - 1)) * trace_hk0hk0 - (2 / n) * squared_trace_hk0
+  const DoubleDouble first_coefficient =
+    ddSubtract(makeDoubleDouble(2), ddDivide(makeDoubleDouble(12), n - 1.0));
+  const DoubleDouble gaussian_part =
+    ddSubtract(ddMultiply(first_coefficient, trace_hk0hk0),
+               ddMultiply(ddDivide(makeDoubleDouble(2), n), squared_trace_hk0));
+
+  // fourth_moment * ((6 / n) * trace_hk0hk0 + (1 / n) * squared_trace_hk0 +
+  //                  trace_hk0h_hadamard)
+  const DoubleDouble kurtosis_factor =
+    ddAdd(ddAdd(ddMultiply(ddDivide(makeDoubleDouble(6), n), trace_hk0hk0),
+                ddMultiply(one_over_n, squared_trace_hk0)),
+          trace_hk0h_hadamard);
+
+  return toDouble(
+    ddAdd(gaussian_part, ddMultiply(kurtosis_term, kurtosis_factor)));
+}
\ No newline at end of file
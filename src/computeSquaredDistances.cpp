@@ -0,0 +1,44 @@
+/* Computes the squared Euclidean distances between the rows of a matrix
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeSquaredDistances.h"
+
+// Uses ||a - b||^2 = ||a||^2 + ||b||^2 - 2 * a'b, so the pairwise work is a
+// single BLAS Gram product. The columns of 'x' are centered first (distances
+// are translation invariant) to limit cancellation in the subtraction; small
+// negative values left by rounding are clamped to zero and the diagonal is set
+// to exactly zero
+arma::mat computeSquaredDistances(const arma::mat& x) {
+  const arma::uword sample_size = x.n_rows;
+  const arma::mat x_centered = x.each_row() - arma::mean(x, 0);
+  arma::mat squared_distances = x_centered * x_centered.t();
+  const arma::vec squared_norms = squared_distances.diag();
+  for (arma::uword j = 0; j < sample_size; ++j) {
+    double* distance_col = squared_distances.colptr(j);
+    for (arma::uword i = 0; i < j; ++i) { // upper triangle
+      const double distance =
+        squared_norms[i] + squared_norms[j] - 2 * distance_col[i];
+      distance_col[i] = (distance > 0) ? distance : 0;
+    }
+    distance_col[j] = 0;
+  }
+  return arma::symmatu(squared_distances); //reflect upper to lower
+}
\ No newline at end of file
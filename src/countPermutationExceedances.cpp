@@ -0,0 +1,80 @@
+/* Stores shared permutations and counts permutation statistics exceeding an
+ observed statistic, with optional sequential stopping
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "countPermutationExceedances.h"
+#include "generatePermutation.h"
+
+namespace {
+
+// the row orders are kept if they take no more than 32 MB (2^23 entries of 4
+// bytes; arma::uword is 32-bit by default)
+const uint64_t kMaxStoredRowOrderEntries = 1 << 23;
+
+arma::umat generateRowOrders(arma::uword n,
+                             uint64_t seed,
+                             PermutationStream stream,
+                             int num_permutations) {
+  arma::umat row_orders(n, num_permutations);
+  for (int k = 0; k < num_permutations; ++k) {
+    row_orders.col(k) = generatePermutation(n, seed, stream, k);
+  }
+  return row_orders;
+}
+
+} // namespace
+
+// The same permutations are used for every set or phenotype in a batch, so
+// they are generated once when they fit in memory
+PermutationTable buildPermutationTable(arma::uword n,
+                                       uint64_t seed,
+                                       int num_permutations,
+                                       bool use_filter_reference) {
+  PermutationTable permutations;
+  permutations.n = n;
+  permutations.seed = seed;
+  // counted in 64 bits, since n * num_permutations can overflow arma::uword
+  const uint64_t num_entries = static_cast<uint64_t>(n) * num_permutations *
+    (use_filter_reference ? 2 : 1);
+  if (num_entries <= kMaxStoredRowOrderEntries) {
+    permutations.response_row_orders =
+      generateRowOrders(n, seed, kResponseStream, num_permutations);
+    if (use_filter_reference) {
+      permutations.filter_reference_row_orders =
+        generateRowOrders(n, seed, kFilterReferenceStream, num_permutations);
+    }
+  }
+  return permutations;
+}
+
+// Permutation 'index' of 'stream', as generatePermutation would return it
+arma::uvec getPermutation(const PermutationTable& permutations,
+                          PermutationStream stream,
+                          int index) {
+  const arma::umat& row_orders = (stream == kResponseStream) ?
+    permutations.response_row_orders :
+    permutations.filter_reference_row_orders;
+  if ((stream != kObservedFilterReferenceStream) && !row_orders.is_empty()) {
+    return row_orders.col(index);
+  }
+  return generatePermutation(permutations.n, permutations.seed, stream,
+                             index);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/* Stores shared permutations and counts permutation statistics exceeding an
+ observed statistic, with optional sequential stopping
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_COUNTPERMUTATIONEXCEEDANCES_H_
+#define AMKAT_SRC_COUNTPERMUTATIONEXCEEDANCES_H_
+
+#include <cstdint>
+
+#include "generatePermutation.h"
+
+// Permutations 0, ..., num_permutations - 1 of the response stream and, if
+// used, the filter reference stream. The row orders are empty when they are
+// not stored, in which case they are regenerated on demand
+struct PermutationTable {
+  arma::uword n = 0;
+  uint64_t seed = 0;
+  arma::umat response_row_orders;
+  arma::umat filter_reference_row_orders;
+};
+
+struct ExceedanceCount {
+  int num_permutations_used = 0;
+  int num_exceedances = 0;
+};
+
+PermutationTable buildPermutationTable(arma::uword n,
+                                       uint64_t seed,
+                                       int num_permutations,
+                                       bool use_filter_reference);
+
+arma::uvec getPermutation(const PermutationTable& permutations,
+                          PermutationStream stream,
+                          int index);
+
+// Evaluates 'permutation_statistic(k)' for k = 0, 1, ... and counts the
+// values at least as large as 'test_statistic'. Stops after
+// 'num_permutations' values or, if 'max_exceedances' is positive, at the
+// 'max_exceedances'-th exceedance (Besag and Clifford, 1991)
+template <typename PermutationStatistic>
+ExceedanceCount countPermutationExceedances(
+    double test_statistic,
+    int num_permutations,
+    int max_exceedances,
+    PermutationStatistic permutation_statistic) {
+  ExceedanceCount count;
+  while (count.num_permutations_used < num_permutations) {
+    const double statistic =
+      permutation_statistic(count.num_permutations_used);
+    ++count.num_permutations_used;
+    if ((test_statistic <= statistic) &&
+        (++count.num_exceedances == max_exceedances)) {
+      break;
+    }
+  }
+  return count;
+}
+
+#endif /* AMKAT_SRC_COUNTPERMUTATIONEXCEEDANCES_H_ */
\ No newline at end of file
@@ -0,0 +1,94 @@
+/* Minimal double-double arithmetic: an unevaluated sum hi + lo of two doubles
+ carrying about 106 bits of significand
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_DOUBLEDOUBLE_H_
+#define AMKAT_SRC_DOUBLEDOUBLE_H_
+
+#include <cmath>
+
+// The error-free transformations below follow Dekker (1971) and Knuth (TAOCP
+// vol. 2); they rely on IEEE round-to-nearest and must not be compiled with
+// value-unsafe optimizations such as -ffast-math
+struct DoubleDouble {
+  double hi;
+  double lo;
+};
+
+inline DoubleDouble makeDoubleDouble(double a) {
+  DoubleDouble out = {a, 0.0};
+  return out;
+}
+
+// s + e == a + b exactly, assuming |a| >= |b|
+inline DoubleDouble quickTwoSum(double a, double b) {
+  const double s = a + b;
+  DoubleDouble out = {s, b - (s - a)};
+  return out;
+}
+
+// s + e == a + b exactly
+inline DoubleDouble twoSum(double a, double b) {
+  const double s = a + b;
+  const double b_virtual = s - a;
+  DoubleDouble out = {s, (a - (s - b_virtual)) + (b - b_virtual)};
+  return out;
+}
+
+// p + e == a * b exactly
+inline DoubleDouble twoProd(double a, double b) {
+  const double p = a * b;
+  DoubleDouble out = {p, std::fma(a, b, -p)};
+  return out;
+}
+
+inline DoubleDouble ddNegate(const DoubleDouble& a) {
+  DoubleDouble out = {-a.hi, -a.lo};
+  return out;
+}
+
+inline DoubleDouble ddAdd(const DoubleDouble& a, const DoubleDouble& b) {
+  DoubleDouble s = twoSum(a.hi, b.hi);
+  const DoubleDouble t = twoSum(a.lo, b.lo);
+  s = quickTwoSum(s.hi, s.lo + t.hi);
+  return quickTwoSum(s.hi, s.lo + t.lo);
+}
+
+inline DoubleDouble ddSubtract(const DoubleDouble& a, const DoubleDouble& b) {
+  return ddAdd(a, ddNegate(b));
+}
+
+inline DoubleDouble ddMultiply(const DoubleDouble& a, const DoubleDouble& b) {
+  const DoubleDouble p = twoProd(a.hi, b.hi);
+  return quickTwoSum(p.hi, p.lo + (a.hi * b.lo + a.lo * b.hi));
+}
+
+inline DoubleDouble ddDivide(const DoubleDouble& a, double b) {
+  const double q1 = a.hi / b;
+  const DoubleDouble p = twoProd(q1, b);
+  const DoubleDouble s = twoSum(a.hi, -p.hi);
+  const double q2 = (s.hi + (s.lo - p.lo + a.lo)) / b;
+  return quickTwoSum(q1, q2);
+}
+
+inline double toDouble(const DoubleDouble& a) {
+  return a.hi + a.lo;
+}
+
+#endif /* AMKAT_SRC_DOUBLEDOUBLE_H_ */
\ No newline at end of file
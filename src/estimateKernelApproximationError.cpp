@@ -0,0 +1,52 @@
+/* Estimates the error of the low-rank (Nystrom) approximation of each
+ candidate kernel on a subsample of the rows of x
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "generateCrossKernelMatrix.h"
+#include "generateNystromFeatures.h"
+#include "estimateKernelApproximationError.h"
+
+// For each candidate kernel, returns ||K_s - F_s * F_s'|| / ||K_s|| (Frobenius
+// norms), where K_s is the exact uncentered kernel matrix of the rows
+// 'subsample_rows' of 'x' and F_s their Nystrom features computed from the
+// landmarks 'landmark_rows'. Costs O(s^2 + s * m) per kernel for a subsample
+// of size s and m landmarks
+// [[Rcpp::export]]
+arma::vec estimateKernelApproximationError(
+    const arma::mat& x,
+    const Rcpp::CharacterVector& candidate_kernels,
+    const arma::uvec& landmark_rows,
+    const arma::uvec& subsample_rows) {
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const arma::mat landmarks = x.rows(landmark_rows);
+  const arma::mat subsample = x.rows(subsample_rows);
+  arma::vec relative_errors(kernel_names.size());
+  for (std::size_t j = 0; j < kernel_names.size(); ++j) {
+    const arma::mat exact_kernel =
+      generateCrossKernelMatrix(subsample, subsample, kernel_names[j]);
+    const arma::mat features =
+      generateNystromFeatures(subsample, landmarks, kernel_names[j]);
+    relative_errors[j] = arma::norm(exact_kernel - features * features.t(),
+                                    "fro") / arma::norm(exact_kernel, "fro");
+  }
+  return relative_errors;
+}
\ No newline at end of file
@@ -20,11 +20,11 @@
 
 #include <RcppArmadillo.h>
 
-// Using mpf_float_100 type for increased precision (from boost header package)
-// mpf_float types use mpfr and gmp libraries from BH (boost header) package;
-// need flags for linking -lmpfr -lgmp to PKG_LIBS in makevars and makevars.win
-#include <boost/multiprecision/mpfr.hpp>
-namespace mp = boost::multiprecision;
+#include "computeKernelMoments.h"
+#include "computeLowRankKernelMoments.h"
+#include "computeSnrVariance.h"
+#include "estimateSignalToNoise.h"
+#include "multiplyKernelMatrix.h"
 
 using namespace arma;
 
@@ -37,28 +37,48 @@ using namespace arma;
 double estimateSignalToNoise(const arma::vec& y,
                              double y_variance,
                              const arma::mat& kernel_matrix) {
+  return estimateSignalToNoiseFromMoments(y, y_variance,
+                                          computeKernelMoments(kernel_matrix));
+}
+
+// Same as above, with the y-independent terms taken from 'kernel_moments' so
+// that only the quadratic form y' * K0 * y is computed per call (O(n^2), or
+// O(n * m) for a rank-m kernel)
+double estimateSignalToNoiseFromMoments(const arma::vec& y,
+                                        double y_variance,
+                                        const KernelMoments& kernel_moments) {
   const int n = y.size();
-  arma::mat kernel_matrix_diag0 = kernel_matrix;
-  kernel_matrix_diag0.diag().zeros();
-  const arma::mat centering_matrix = eye(n, n) - mat(n, n, fill::ones) / n;
-  const arma::mat hk0 = centering_matrix * kernel_matrix_diag0;
-  const arma::mat hk0hk0 = hk0 * hk0;
-  const arma::mat hk0h = hk0 * centering_matrix;
-  const arma::mat hk0h_hadamard = hk0h % hk0h;
-  const mp::mpf_float_100 trace_hk0h_hadamard = trace(hk0h_hadamard);
-  const mp::mpf_float_100 squared_trace_hk0 = trace(hk0) * trace(hk0);
-  const mp::mpf_float_100 trace_hk0hk0 = trace(hk0hk0);
   const arma::vec y_standardized = y/sqrt(y_variance);
   const arma::vec fourth_power = pow(y_standardized, 4);
-  const mp::mpf_float_100 n_float(n);
-  const mp::mpf_float_100 fourth_moment = mean(fourth_power) - 3;
-  const mp::mpf_float_100 snr_variance_float =
-    (2 - 12 / (n_float - 1)) * trace_hk0hk0 -
-    (2 / n_float) * squared_trace_hk0 +
-    fourth_moment * ((6 / n_float) * trace_hk0hk0 +
-    (1 / n_float) * squared_trace_hk0 + trace_hk0h_hadamard);
-  const double snr_variance = snr_variance_float.convert_to<double>();
-  const double signal_to_noise =
-    (as_scalar(y.t() * kernel_matrix_diag0 * y)) / y_variance;
+  const double fourth_moment = mean(fourth_power) - 3;
+  const double snr_variance =
+    computeSnrVariance(n, kernel_moments, fourth_moment);
+  const double quadratic_form = kernel_moments.features.is_empty() ?
+    dot(y, multiplyKernelMatrix(kernel_moments, y)) :
+    computeLowRankQuadraticForms(y, kernel_moments)[0];
+  const double signal_to_noise = quadratic_form / y_variance;
     return signal_to_noise / sqrt(snr_variance);
+}
+
+// Same as above for every column i of 'y', with variance 'y_variances[i]'. The
+// quadratic forms of all columns come from one matrix-matrix product with K0
+// (or with the features of a low-rank kernel), so stacking many columns, e.g.
+// the permuted copies of y from a batch of permutations, gives BLAS-3 speed
+arma::rowvec estimateSignalToNoiseColumns(const arma::mat& y,
+                                          const arma::vec& y_variances,
+                                          const KernelMoments& kernel_moments) {
+  const int n = y.n_rows;
+  const arma::rowvec quadratic_forms = kernel_moments.features.is_empty() ?
+    arma::rowvec(sum(y % multiplyKernelMatrix(kernel_moments, y), 0)) :
+    computeLowRankQuadraticForms(y, kernel_moments);
+  arma::rowvec signal_to_noise(y.n_cols);
+  for (uword i = 0; i < y.n_cols; ++i) {
+    const arma::vec y_standardized = y.col(i)/sqrt(y_variances[i]);
+    const double fourth_moment = mean(pow(y_standardized, 4)) - 3;
+    const double snr_variance =
+      computeSnrVariance(n, kernel_moments, fourth_moment);
+    signal_to_noise[i] =
+      (quadratic_forms[i] / y_variances[i]) / sqrt(snr_variance);
+  }
+  return signal_to_noise;
 }
\ No newline at end of file
@@ -21,8 +21,18 @@
 #ifndef AMKAT_SRC_ESTIMATESIGNALTONOISE_H_
 #define AMKAT_SRC_ESTIMATESIGNALTONOISE_H_
 
+#include "computeKernelMoments.h"
+
 double estimateSignalToNoise(const arma::vec& y,
                              double y_variance, 
                              const arma::mat& kernel_matrix);
 
+double estimateSignalToNoiseFromMoments(const arma::vec& y,
+                                        double y_variance,
+                                        const KernelMoments& kernel_moments);
+
+arma::rowvec estimateSignalToNoiseColumns(const arma::mat& y,
+                                          const arma::vec& y_variances,
+                                          const KernelMoments& kernel_moments);
+
 #endif /* AMKAT_SRC_ESTIMATESIGNALTONOISE_H_ */
\ No newline at end of file
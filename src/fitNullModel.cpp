@@ -0,0 +1,59 @@
+/* Fits the null model (intercept and linear covariate effects) by ordinary
+ least squares, returning the residuals and the residual variance estimates
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "fitNullModel.h"
+
+using namespace arma;
+
+// 'covariates' has the same number of rows as 'y' and may have no columns.
+// The intercept is removed by centering; since the centered covariates are
+// orthogonal to the intercept, the remaining projection uses a thin QR of the
+// centered covariates, so the fit takes O(n * c^2) time and O(n * c) memory
+// and never forms the n x n hat matrix
+// [[Rcpp::export]]
+Rcpp::List fitNullModel(const arma::mat& y, const arma::mat& covariates) {
+  const arma::uword n = y.n_rows;
+  const arma::uword num_covariates = covariates.n_cols;
+  arma::mat residuals = y.each_row() - mean(y, 0);
+  if (num_covariates > 0) {
+    const arma::mat centered_covariates =
+      covariates.each_row() - mean(covariates, 0);
+    arma::mat q, r;
+    if (!qr_econ(q, r, centered_covariates)) {
+      Rcpp::stop("QR decomposition of the covariates failed");
+    }
+    // same relative tolerance as R's qr()
+    const arma::vec abs_r_diagonal = abs(r.diag());
+    if (abs_r_diagonal.min() <= 1e-7 * abs_r_diagonal.max()) {
+      Rcpp::stop(
+        "cannot fit null model: the covariates (with an intercept) are "
+        "linearly dependent");
+    }
+    residuals -= q * (q.t() * residuals);
+  }
+  const arma::rowvec standard_errors =
+    sum(y % residuals, 0) / (n - num_covariates - 1.0);
+  return Rcpp::List::create(
+    Rcpp::Named("residuals") = residuals,
+    Rcpp::Named("standard_errors") =
+      Rcpp::NumericVector(standard_errors.begin(), standard_errors.end()));
+}
\ No newline at end of file
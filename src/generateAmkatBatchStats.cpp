@@ -0,0 +1,186 @@
+/* Generates the observed test statistic and the permutation statistics for
+ each of many sets of columns of x, sharing the work that depends only on y
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "applyAmkatFilter.h"
+#include "computeRankCache.h"
+#include "buildSpearmanTailTable.h"
+#include "computeKernelMoments.h"
+#include "computeKernelSums.h"
+#include "computeMaxSnrStatistic.h"
+#include "countPermutationExceedances.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
+#include "generatePermutation.h"
+#include "generateAmkatBatchStats.h"
+
+using namespace arma;
+
+// 'x_sets' is a list of integer vectors of (0-based) column indices of 'x';
+// other arguments are as for generatePermStats, generateTestStatMultiple and
+// generatePermStatsNoFilter, with 'max_exceedances' = 0 disabling sequential
+// stopping. The filter is skipped for sets with a single column.
+// y is ranked once, x's columns are ranked once however many sets contain
+// them, and every set is tested with the same permutations, which are
+// generated once when they fit in memory. Sets are distributed over threads,
+// and each set's permutations run on one thread, so sequential stopping is
+// exact; as elsewhere, the results do not depend on the number of threads
+// 'landmark_rows' (0-based rows of 'x') selects Nystrom landmarks for a
+// low-rank kernel approximation; if empty the kernels are exact
+// 'kernel_storage' ("dense", "packed" or "float") selects how exact n x n
+// kernels are held; see packKernelMoments.cpp
+// [[Rcpp::export]]
+Rcpp::List generateAmkatBatchStats(const arma::mat& y,
+                                   const arma::vec& y_variances,
+                                   const arma::mat& x,
+                                   const Rcpp::List& x_sets,
+                                   const Rcpp::CharacterVector& candidate_kernels,
+                                   bool filter_x,
+                                   int num_test_statistics,
+                                   int num_permutations,
+                                   int max_exceedances,
+                                   int num_threads,
+                                   const arma::uvec& landmark_rows,
+                                   const std::string& kernel_storage) {
+  const arma::uword n = y.n_rows;
+  const int num_sets = x_sets.size();
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const KernelStorage kernel_storage_mode = getKernelStorage(kernel_storage);
+  std::vector<arma::uvec> set_columns(num_sets);
+  bool filter_any_set = false;
+  double num_filtered_columns = 0;
+  for (int s = 0; s < num_sets; ++s) {
+    set_columns[s] = Rcpp::as<arma::uvec>(x_sets[s]);
+    if (filter_x && (set_columns[s].n_elem > 1)) {
+      filter_any_set = true;
+      num_filtered_columns += set_columns[s].n_elem;
+    }
+  }
+#ifndef _OPENMP
+  num_threads = 1;
+#endif
+
+  // shared across sets; the ranks and the tail table are only built if some
+  // set is filtered
+  const uint64_t seed = drawPermutationSeed();
+  const RankCache y_ranks =
+    filter_any_set ? computeRankCache(y) : RankCache();
+  const RankCache x_ranks =
+    filter_any_set ? computeRankCache(x) : RankCache();
+  // sequential stopping may use fewer permutations than are counted here
+  const SpearmanTailTable tail_table = filter_any_set ?
+    buildSpearmanTailTable(
+      n, y_ranks, x_ranks,
+      countFilterQueries(y.n_cols, num_filtered_columns,
+                         num_test_statistics + num_permutations)) :
+    SpearmanTailTable();
+  const PermutationTable permutations =
+    buildPermutationTable(n, seed, num_permutations, filter_any_set);
+
+  arma::vec test_statistics(num_sets, fill::zeros);
+  arma::vec num_permutations_used(num_sets, fill::zeros);
+  arma::vec num_exceedances(num_sets, fill::zeros);
+  const int block_size = std::min(num_sets, 16 * num_threads);
+  for (int block_start = 0; block_start < num_sets;
+       block_start += block_size) {
+    const int block_end = std::min(block_start + block_size, num_sets);
+#pragma omp parallel num_threads(num_threads)
+    {
+      // per-thread workspace
+      std::vector<KernelMoments> kernel_moments;
+      KernelSums kernel_sums;
+      arma::mat y_permuted_rows(y);
+      arma::uvec y_row_order(n);
+#pragma omp for schedule(dynamic)
+      for (int s = block_start; s < block_end; ++s) {
+        const arma::uvec& columns = set_columns[s];
+        const arma::mat x_set = x.cols(columns);
+        const bool filter_set = filter_x && (columns.n_elem > 1);
+        RankCache x_set_ranks;
+        if (filter_set) {
+          x_set_ranks.standardized_ranks =
+            x_ranks.standardized_ranks.cols(columns);
+          x_set_ranks.has_ties = x_ranks.has_ties.elem(columns);
+        }
+        // the filtered kernels of a set are updated incrementally from one
+        // selection to the next (see computeKernelSums.h); the statistics of
+        // a set are computed in order on one thread, so they do not depend on
+        // the number of threads
+        kernel_sums = KernelSums();
+        auto updateKernelMoments = [&](const arma::uvec& selected_x_columns) {
+          kernel_moments = updateAllKernelMoments(
+            kernel_sums, x_set, selected_x_columns, kernel_names,
+            landmark_rows, kernel_storage_mode);
+        };
+
+        // observed statistic; without the filter the kernels do not change
+        // across permutations
+        double test_statistic = 0;
+        if (filter_set) {
+          // only the reference copy of x changes between repetitions
+          const arma::vec observed_min_pvalues =
+            computeObservedFilterPvalues(y_ranks, x_set_ranks, tail_table);
+          for (int r = 0; r < num_test_statistics; ++r) {
+            const arma::uvec selected_x_columns = applyAmkatFilterToReference(
+              observed_min_pvalues, y_ranks, x_set_ranks,
+              generatePermutation(n, seed, kObservedFilterReferenceStream, r),
+              tail_table);
+            updateKernelMoments(selected_x_columns);
+            test_statistic +=
+              computeMaxSnrStatistic(y, y_variances, kernel_moments);
+          }
+          test_statistic /= num_test_statistics;
+        } else {
+          kernel_moments =
+            generateAllKernelMoments(x_set, kernel_names, landmark_rows,
+                                     kernel_storage_mode);
+          test_statistic =
+            computeMaxSnrStatistic(y, y_variances, kernel_moments);
+        }
+
+        const ExceedanceCount count = countPermutationExceedances(
+          test_statistic, num_permutations, max_exceedances,
+          [&](int k) -> double {
+            y_row_order = getPermutation(permutations, kResponseStream, k);
+            y_permuted_rows = y.rows(y_row_order);
+            if (filter_set) {
+              const arma::uvec selected_x_columns = applyAmkatFilterToRanks(
+                y_ranks, y_row_order, x_set_ranks,
+                getPermutation(permutations, kFilterReferenceStream, k),
+                tail_table);
+              updateKernelMoments(selected_x_columns);
+            }
+            return computeMaxSnrStatistic(y_permuted_rows, y_variances,
+                                          kernel_moments);
+          });
+        test_statistics[s] = test_statistic;
+        num_permutations_used[s] = count.num_permutations_used;
+        num_exceedances[s] = count.num_exceedances;
+      }
+    }
+    Rcpp::checkUserInterrupt();
+  }
+  return Rcpp::List::create(
+    Rcpp::Named("test_statistic") = test_statistics,
+    Rcpp::Named("number_of_permutations") = num_permutations_used,
+    Rcpp::Named("number_of_exceedances") = num_exceedances);
+}
\ No newline at end of file
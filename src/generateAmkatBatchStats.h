@@ -0,0 +1,37 @@
+/* Generates the observed test statistic and the permutation statistics for
+ each of many sets of columns of x, sharing the work that depends only on y
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_GENERATEAMKATBATCHSTATS_H_
+#define AMKAT_SRC_GENERATEAMKATBATCHSTATS_H_
+
+Rcpp::List generateAmkatBatchStats(const arma::mat& y,
+                                   const arma::vec& y_variances,
+                                   const arma::mat& x,
+                                   const Rcpp::List& x_sets,
+                                   const Rcpp::CharacterVector& candidate_kernels,
+                                   bool filter_x,
+                                   int num_test_statistics,
+                                   int num_permutations,
+                                   int max_exceedances,
+                                   int num_threads,
+                                   const arma::uvec& landmark_rows,
+                                   const std::string& kernel_storage);
+
+#endif /* AMKAT_SRC_GENERATEAMKATBATCHSTATS_H_ */
\ No newline at end of file
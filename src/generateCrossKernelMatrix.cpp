@@ -0,0 +1,70 @@
+/* Evaluates a kernel function (without centering) at every pair of a row of x
+ and a row of z
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "generateCrossKernelMatrix.h"
+
+// 'x' and 'z' have the same number of columns; entry (i, j) of the result is
+// the kernel function evaluated at row i of 'x' and row j of 'z', with the
+// same definitions (and the same scaling by the number of columns p) as in
+// generateKernelMatrix
+arma::mat generateCrossKernelMatrix(const arma::mat& x,
+                                    const arma::mat& z,
+                                    const std::string& kernel_function) {
+  const int p = x.n_cols;
+  arma::mat kernel_matrix(x.n_rows, z.n_rows, arma::fill::zeros);
+  if (kernel_function == "lin") {
+    kernel_matrix = (x * z.t()) / p;
+  } else if (kernel_function == "quad") {
+    kernel_matrix = pow((x * z.t()) / p + 1, 2.0);
+  } else if ((kernel_function == "gau") || (kernel_function == "exp")) {
+    // distances from a Gram product of data shifted by the means of 'z',
+    // which limits cancellation as in computeSquaredDistances
+    const arma::rowvec shift = arma::mean(z, 0);
+    const arma::mat x_shifted = x.each_row() - shift;
+    const arma::mat z_shifted = z.each_row() - shift;
+    const arma::vec x_squared_norms = arma::sum(arma::square(x_shifted), 1);
+    const arma::rowvec z_squared_norms =
+      arma::sum(arma::square(z_shifted), 1).t();
+    arma::mat squared_distances = -2 * (x_shifted * z_shifted.t());
+    squared_distances.each_col() += x_squared_norms;
+    squared_distances.each_row() += z_squared_norms;
+    squared_distances.clamp(0, arma::datum::inf);
+    if (kernel_function == "gau") {
+      kernel_matrix = arma::exp(-squared_distances / p);
+    } else {
+      // exp((-||x_i||^2 - 3 * ||x_i - z_j||^2 - ||z_j||^2) / p)
+      kernel_matrix = 3 * squared_distances;
+      kernel_matrix.each_col() += arma::sum(arma::square(x), 1);
+      kernel_matrix.each_row() += arma::sum(arma::square(z), 1).t();
+      kernel_matrix = arma::exp(-kernel_matrix / p);
+    }
+  } else if (kernel_function == "IBS") {
+    for (arma::uword j = 0; j < z.n_rows; ++j) {
+      const arma::rowvec z_row = z.row(j);
+      for (arma::uword i = 0; i < x.n_rows; ++i) {
+        kernel_matrix(i, j) =
+          1 - arma::accu(arma::abs(x.row(i) - z_row)) / (2 * p);
+      }
+    }
+  }
+  return kernel_matrix;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+/* Generates the (uncentered) identical-by-state kernel matrix from packed
+ genotypes using bitwise XOR and popcount
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "packGenotypes.h"
+#include "generateIbsKernelPacked.h"
+
+namespace {
+
+inline unsigned int countBits(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(word);
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (word * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+} // namespace
+
+// Manhattan distances sum(|x_i - x_j|), counted exactly as integers from the
+// two bit-planes of each sample
+arma::mat computeManhattanDistancesPacked(const PackedGenotypes& genotypes) {
+  const arma::uword sample_size = genotypes.num_samples;
+  const arma::uword words_per_sample = 2 * genotypes.words_per_sample;
+  arma::mat manhattan_distances(sample_size, sample_size);
+  for (arma::uword j = 0; j < sample_size; ++j) {
+    const uint64_t* bits_j = &genotypes.bits[words_per_sample * j];
+    double* distance_col = manhattan_distances.colptr(j);
+    for (arma::uword i = 0; i <= j; ++i) { // upper triangle
+      const uint64_t* bits_i = &genotypes.bits[words_per_sample * i];
+      arma::uword manhattan_distance = 0;
+      for (arma::uword w = 0; w < words_per_sample; ++w) {
+        manhattan_distance += countBits(bits_i[w] ^ bits_j[w]);
+      }
+      distance_col[i] = manhattan_distance;
+    }
+  }
+  return arma::symmatu(manhattan_distances); //reflect upper to lower
+}
+
+// Same kernel as the "IBS" branch of generateKernelMatrix:
+// 1 - sum(|x_i - x_j|) / (2 * p)
+arma::mat generateIbsKernelPacked(const PackedGenotypes& genotypes) {
+  const double scale = 2.0 * genotypes.num_variants;
+  return 1 - computeManhattanDistancesPacked(genotypes) / scale;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+/* Generates the explicit (finite-dimensional) feature map of the linear and
+ quadratic kernels
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "generateKernelFeatures.h"
+
+// Number of columns of generateKernelFeatures(x, kernel_function) for 'x' with
+// 'p' columns, or 0 if the kernel has no (implemented) explicit feature map
+arma::uword getKernelFeatureDimension(arma::uword p,
+                                      const std::string& kernel_function) {
+  if (kernel_function == "lin") {
+    return p;
+  } else if (kernel_function == "quad") {
+    return 1 + p + p * (p + 1) / 2;
+  }
+  return 0;
+}
+
+// Row i of the result is the feature vector of row i of 'x', so that
+// features * features.t() is exactly the (uncentered) kernel matrix of
+// generateKernelMatrix:
+//   lin:  x_i' x_j / p                        features x / sqrt(p)
+//   quad: (x_i' x_j / p + 1)^2                features 1, sqrt(2 / p) * x_k,
+//                                             x_k^2 / p, sqrt(2) * x_k x_l / p
+//                                             (k < l)
+arma::mat generateKernelFeatures(const arma::mat& x,
+                                 const std::string& kernel_function) {
+  const arma::uword p = x.n_cols;
+  if (kernel_function == "lin") {
+    return x / std::sqrt(static_cast<double>(p));
+  }
+  arma::mat features(x.n_rows, getKernelFeatureDimension(p, kernel_function));
+  features.col(0).ones();
+  features.cols(1, p) = x * std::sqrt(2.0 / p);
+  arma::uword column = p + 1;
+  for (arma::uword k = 0; k < p; ++k) {
+    features.col(column++) = arma::square(x.col(k)) / p;
+    for (arma::uword l = k + 1; l < p; ++l) {
+      features.col(column++) = (std::sqrt(2.0) / p) * (x.col(k) % x.col(l));
+    }
+  }
+  return features;
+}
\ No newline at end of file
@@ -20,57 +20,22 @@
 
 #include <RcppArmadillo.h>
 
-using namespace Rcpp;
+#include "computeKernelSums.h"
+#include "generateKernelMatrix.h"
+#include "generateKernelMatrixFromSums.h"
 
 /* 'x' contains observations indexed by row.
  * 'kernel_function' accepts any one of the following strings for its value:
  *   "gau", "lin", "quad", "exp", "IBS"
- * If adding to or modifying this list by changing the function definition, it is
- * also necessary to modify the variable 'programmed_kernels' defined in the
- * main R function 'amkat' located in 'AMKAT/R/amkat_functions.R' */
+ * If adding to or modifying this list by changing the function definition in
+ * generateKernelMatrixFromSums.cpp, it is also necessary to modify the variable
+ * 'programmed_kernels' defined in the main R function 'amkat' located in
+ * 'AMKAT/R/amkat_functions.R', and the uncentered kernels in
+ * generateCrossKernelMatrix.cpp */
 // [[Rcpp::export]]
 arma::mat generateKernelMatrix(const arma::mat& x,
-                               const Rcpp::String& kernel_function) {
-  const arma::uword sample_size = x.n_rows;
-  const int n(sample_size);
-  const int p = x.n_cols;
-  arma::mat kernel_matrix(n, n, arma::fill::zeros);
-  if (kernel_function == "gau") {
-    // Picking up gausskernel function from KRLS package
-    Rcpp::Environment pkg = Environment::namespace_env("KRLS");
-    Rcpp::Function f = pkg["gausskernel"];
-    kernel_matrix = as<arma::mat>(f(x, p));
-  } else if (kernel_function == "lin") {
-    kernel_matrix = (x * x.t()) / p;
-  } else if (kernel_function == "quad") {
-    kernel_matrix = (x * x.t()) / p;
-    kernel_matrix = pow(kernel_matrix + 1, 2.0);
-  } else if (kernel_function == "exp") {
-    for (arma::uword j = 0; j < sample_size; ++j) {
-      const Rcpp::NumericVector x1 =
-        Rcpp::as<NumericVector>(Rcpp::wrap(x.row(j)));
-      for (arma::uword i = 0; i < (j + 1); ++i) { // upper triangle
-        const NumericVector x2 = Rcpp::as<NumericVector>(Rcpp::wrap(x.row(i)));
-        kernel_matrix(i, j) =
-          exp((-sum(pow(x1, 2.0)) - 3 * sum(pow(x1 - x2, 2.0)) -
-          sum(pow(x2, 2.0))) / p);
-      }
-    }
-    kernel_matrix = arma::symmatu(kernel_matrix); //reflect upper to lower
-  } else if (kernel_function == "IBS") {
-    for (arma::uword j = 0; j < sample_size; ++j) {
-      const arma::rowvec x1 = x.row(j);
-      for (arma::uword i = 0; i < (j + 1); ++i) { // upper triangle
-        const arma::rowvec manhattan_dist_components(abs(x1 - x.row(i)));
-        kernel_matrix(i, j) = 1 - (sum(manhattan_dist_components) / (2 * p));
-      }
-    }
-    kernel_matrix = arma::symmatu(kernel_matrix); //reflect upper to lower
-  }
-  // empirical centralized kernel matrix
-  arma::mat ker0 = kernel_matrix;
-  ker0.diag().zeros();
-  const arma::mat J(n, n, arma::fill::ones);
-  return kernel_matrix -
-    (J * ker0 + ker0 * J - (J * ker0 * J) / n ) / (n - 1);
+                               const std::string& kernel_function) {
+  return generateKernelMatrixFromSums(
+    computeKernelSums(x, std::vector<std::string>(1, kernel_function)),
+    kernel_function);
 }
\ No newline at end of file
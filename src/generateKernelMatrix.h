@@ -22,6 +22,6 @@
 #define AMKAT_SRC_GENERATEKERNELMATRIX_H_
 
 arma::mat generateKernelMatrix(const arma::mat& x, 
-                               const Rcpp::String& kernel_function);
+                               const std::string& kernel_function);
 
 #endif /* AMKAT_SRC_GENERATEKERNELMATRIX_H_ */
\ No newline at end of file
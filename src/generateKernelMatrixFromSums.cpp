@@ -0,0 +1,119 @@
+/* Generates the empirical centralized kernel similarity matrix of a kernel
+ from sums over the columns of the observations
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelSums.h"
+#include "generateKernelMatrixFromSums.h"
+
+namespace {
+
+enum KernelType { kLinear, kQuadratic, kGaussian, kExponential, kIbs, kOther };
+
+KernelType getKernelType(const std::string& kernel_function) {
+  if (kernel_function == "lin") return kLinear;
+  if (kernel_function == "quad") return kQuadratic;
+  if (kernel_function == "gau") return kGaussian;
+  if (kernel_function == "exp") return kExponential;
+  if (kernel_function == "IBS") return kIbs;
+  return kOther;
+}
+
+// empirical centralized kernel matrix: with K0 the kernel matrix with zero
+// diagonal and J the n x n matrix of ones, J * K0, K0 * J and J * K0 * J
+// hold the column sums, row sums and grand sum of K0, so the correction
+// (J * K0 + K0 * J - J * K0 * J / n) / (n - 1) is applied entrywise
+void centerKernelMatrix(arma::mat& kernel_matrix) {
+  const arma::uword sample_size = kernel_matrix.n_rows;
+  const int n(sample_size);
+  const arma::vec kernel_diagonal = kernel_matrix.diag();
+  const arma::rowvec column_sums_ker0 =
+    arma::sum(kernel_matrix, 0) - kernel_diagonal.t();
+  const arma::vec row_sums_ker0 = arma::sum(kernel_matrix, 1) - kernel_diagonal;
+  const double grand_sum_ker0 = arma::accu(row_sums_ker0);
+  for (arma::uword j = 0; j < sample_size; ++j) {
+    const double offset_j = column_sums_ker0[j] - grand_sum_ker0 / n;
+    double* kernel_col = kernel_matrix.colptr(j);
+    for (arma::uword i = 0; i < sample_size; ++i) {
+      kernel_col[i] -= (row_sums_ker0[i] + offset_j) / (n - 1);
+    }
+  }
+}
+
+} // namespace
+
+/* 'kernel_function' takes the values accepted by generateKernelMatrix, and
+ * 'kernel_sums' must hold the terms it needs (see computeKernelSums.h). The
+ * lin and quad kernels both use X * X', and the gau and exp kernels both use
+ * the squared distances, so callers that need several kernels form the sums
+ * once and evaluate the kernels from them one at a time. The output is the
+ * centered n x n kernel matrix; an unknown kernel gives a zero matrix */
+arma::mat generateKernelMatrixFromSums(const KernelSums& kernel_sums,
+                                       const std::string& kernel_function) {
+  const int p = kernel_sums.columns.n_elem;
+  const arma::mat& gram = kernel_sums.gram;
+  const arma::mat& squared_distances = kernel_sums.squared_distances;
+  const arma::vec& squared_norms = kernel_sums.squared_norms;
+  const arma::mat& manhattan_distances = kernel_sums.manhattan_distances;
+  const arma::uword sample_size = std::max(
+    std::max(gram.n_rows, squared_distances.n_rows),
+    manhattan_distances.n_rows);
+  const KernelType type = getKernelType(kernel_function);
+  arma::mat kernel_matrix;
+  if (type == kOther) {
+    kernel_matrix.zeros(sample_size, sample_size);
+    centerKernelMatrix(kernel_matrix);
+    return kernel_matrix;
+  }
+  kernel_matrix.set_size(sample_size, sample_size);
+  // the upper triangle is evaluated entrywise:
+  //   lin   X * X' / p
+  //   quad  (X * X' / p + 1)^2
+  //   gau   exp(-||x_i - x_j||^2 / p), same as KRLS::gausskernel(x, sigma = p)
+  //   exp   exp((-||x_i||^2 - 3 * ||x_i - x_j||^2 - ||x_j||^2) / p)
+  //   IBS   1 - sum(|x_i - x_j|) / (2 * p)
+  for (arma::uword j = 0; j < sample_size; ++j) {
+    double* kernel_col = kernel_matrix.colptr(j);
+    if ((type == kLinear) || (type == kQuadratic)) {
+      const double* gram_col = gram.colptr(j);
+      for (arma::uword i = 0; i <= j; ++i) {
+        const double linear = gram_col[i] / p;
+        kernel_col[i] = (type == kLinear) ? linear :
+          (linear + 1) * (linear + 1);
+      }
+    } else if (type == kIbs) {
+      const double* distance_col = manhattan_distances.colptr(j);
+      for (arma::uword i = 0; i <= j; ++i) {
+        kernel_col[i] = 1 - distance_col[i] / (2.0 * p);
+      }
+    } else {
+      const double* distance_col = squared_distances.colptr(j);
+      for (arma::uword i = 0; i <= j; ++i) {
+        kernel_col[i] = (type == kGaussian) ?
+          std::exp(-distance_col[i] / p) :
+          std::exp(-(squared_norms[i] + 3 * distance_col[i] +
+            squared_norms[j]) / p);
+      }
+    }
+  }
+  kernel_matrix = arma::symmatu(kernel_matrix); //reflect upper to lower
+  centerKernelMatrix(kernel_matrix);
+  return kernel_matrix;
+}
\ No newline at end of file
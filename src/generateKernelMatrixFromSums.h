@@ -0,0 +1,31 @@
+/* Generates the empirical centralized kernel similarity matrix of a kernel
+ from sums over the columns of the observations
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_GENERATEKERNELMATRIXFROMSUMS_H_
+#define AMKAT_SRC_GENERATEKERNELMATRIXFROMSUMS_H_
+
+#include <string>
+
+#include "computeKernelSums.h"
+
+arma::mat generateKernelMatrixFromSums(const KernelSums& kernel_sums,
+                                       const std::string& kernel_function);
+
+#endif /* AMKAT_SRC_GENERATEKERNELMATRIXFROMSUMS_H_ */
\ No newline at end of file
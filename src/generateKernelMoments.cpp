@@ -0,0 +1,186 @@
+/* Generates the quantities of a candidate kernel needed by
+ estimateSignalToNoise, exactly or from a low-rank approximation
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "computeLowRankKernelMoments.h"
+#include "generateKernelFeatures.h"
+#include "generateKernelMatrix.h"
+#include "generateKernelMatrixFromSums.h"
+#include "generateNystromFeatures.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
+
+namespace {
+
+inline bool useKernelFeatures(arma::uword sample_size,
+                              arma::uword num_x_variables,
+                              const std::string& kernel_function) {
+  const double n = sample_size;
+  const double p = num_x_variables;
+  const double feature_dimension =
+    getKernelFeatureDimension(num_x_variables, kernel_function);
+  return (feature_dimension > 0) && (feature_dimension < n) &&
+    (feature_dimension * feature_dimension <= n * p);
+}
+
+// indices of the kernels that generateKernelMoments would form as n x n
+// matrices: exact kernels without a cheaper feature map
+std::vector<int> findMatrixKernels(
+    arma::uword sample_size,
+    arma::uword num_x_variables,
+    const std::vector<std::string>& kernel_functions,
+    const arma::uvec& landmark_rows) {
+  std::vector<int> matrix_indices;
+  if (!landmark_rows.is_empty()) return matrix_indices;
+  for (std::size_t j = 0; j < kernel_functions.size(); ++j) {
+    if (!useKernelFeatures(sample_size, num_x_variables,
+                           kernel_functions[j])) {
+      matrix_indices.push_back(j);
+    }
+  }
+  return matrix_indices;
+}
+
+// The kernels in a group are evaluated from the same sum over the columns of
+// x (see computeKernelSums.h): X * X' for lin and quad, the squared distances
+// for gau and exp, and the Manhattan distances for IBS
+const int kNumKernelSumGroups = 3;
+
+int getKernelSumGroup(const std::string& kernel_function) {
+  if ((kernel_function == "lin") || (kernel_function == "quad")) return 0;
+  if ((kernel_function == "gau") || (kernel_function == "exp")) return 1;
+  return 2;
+}
+
+// Evaluates kernels 'indices' of 'kernel_functions' from 'kernel_sums' one at
+// a time; each is reduced to its moments, and packed, before the next one is
+// formed, so at most one n x n kernel is held besides the sums
+void addMatrixKernelMoments(std::vector<KernelMoments>& kernel_moments,
+                            const KernelSums& kernel_sums,
+                            const std::vector<std::string>& kernel_functions,
+                            const std::vector<int>& indices,
+                            KernelStorage kernel_storage) {
+  for (int j : indices) {
+    kernel_moments[j] = computeKernelMoments(
+      generateKernelMatrixFromSums(kernel_sums, kernel_functions[j]));
+    packKernelMoments(kernel_moments[j], kernel_storage);
+  }
+}
+
+} // namespace
+
+// If 'landmark_rows' is empty the kernel is exact: kernels with an explicit
+// feature map of dimension d (lin and quad) are evaluated in feature space,
+// in O(n * d^2) time, when that is cheaper than the O(n^2 * p) of forming the
+// n x n kernel matrix; otherwise the matrix is formed. If 'landmark_rows' is
+// nonempty the kernel is approximated by a Nystrom feature map with the given
+// rows of 'x' as landmarks, and no n x n matrix is formed
+KernelMoments generateKernelMoments(const arma::mat& x,
+                                    const std::string& kernel_function,
+                                    const arma::uvec& landmark_rows) {
+  if (landmark_rows.is_empty()) {
+    if (useKernelFeatures(x.n_rows, x.n_cols, kernel_function)) {
+      return computeLowRankKernelMoments(
+        generateKernelFeatures(x, kernel_function));
+    }
+    return computeKernelMoments(generateKernelMatrix(x, kernel_function));
+  }
+  return computeLowRankKernelMoments(
+    generateNystromFeatures(x, x.rows(landmark_rows), kernel_function));
+}
+
+// Same as above for each of 'kernel_functions', in order. The kernels that
+// are formed as n x n matrices are built a group at a time: the sum shared by
+// the group (e.g. X * X' for lin and quad) is formed once, the group's
+// kernels are evaluated from it one at a time, and it is released before the
+// next group. Besides the stored moments, the peak is then one sum and one
+// n x n kernel, rather than every sum and every kernel at once
+std::vector<KernelMoments> generateAllKernelMoments(
+    const arma::mat& x,
+    const std::vector<std::string>& kernel_functions,
+    const arma::uvec& landmark_rows,
+    KernelStorage kernel_storage) {
+  std::vector<KernelMoments> kernel_moments(kernel_functions.size());
+  const std::vector<int> matrix_indices =
+    findMatrixKernels(x.n_rows, x.n_cols, kernel_functions, landmark_rows);
+  std::vector<std::vector<int> > group_indices(kNumKernelSumGroups);
+  for (std::size_t j = 0, m = 0; j < kernel_functions.size(); ++j) {
+    if ((m < matrix_indices.size()) && (matrix_indices[m] == int(j))) {
+      group_indices[getKernelSumGroup(kernel_functions[j])].push_back(j);
+      ++m;
+    } else {
+      kernel_moments[j] =
+        generateKernelMoments(x, kernel_functions[j], landmark_rows);
+    }
+  }
+  for (const std::vector<int>& indices : group_indices) {
+    if (indices.empty()) continue;
+    std::vector<std::string> group_kernels;
+    for (int j : indices) group_kernels.push_back(kernel_functions[j]);
+    addMatrixKernelMoments(kernel_moments, computeKernelSums(x, group_kernels),
+                           kernel_functions, indices, kernel_storage);
+  }
+  return kernel_moments;
+}
+
+// Same as generateAllKernelMoments(x.cols(selected_x_columns), ...), except
+// that the n x n kernels are evaluated from 'kernel_sums', which is first
+// updated from the columns selected in the previous call (see
+// computeKernelSums.cpp). When consecutive selections share most of their
+// columns, this replaces the O(n^2 * p) products by O(n^2) work per changed
+// column. The sums are full n x n matrices, so with packed 'kernel_storage'
+// the kernels are built from scratch instead
+std::vector<KernelMoments> updateAllKernelMoments(
+    KernelSums& kernel_sums,
+    const arma::mat& x,
+    const arma::uvec& selected_x_columns,
+    const std::vector<std::string>& kernel_functions,
+    const arma::uvec& landmark_rows,
+    KernelStorage kernel_storage) {
+  if (kernel_storage != kDenseStorage) {
+    return generateAllKernelMoments(x.cols(selected_x_columns),
+                                    kernel_functions, landmark_rows,
+                                    kernel_storage);
+  }
+  std::vector<KernelMoments> kernel_moments(kernel_functions.size());
+  const std::vector<int> matrix_indices =
+    findMatrixKernels(x.n_rows, selected_x_columns.n_elem, kernel_functions,
+                      landmark_rows);
+  std::vector<std::string> matrix_kernels;
+  arma::mat x_selected;
+  for (std::size_t j = 0, m = 0; j < kernel_functions.size(); ++j) {
+    if ((m < matrix_indices.size()) && (matrix_indices[m] == int(j))) {
+      matrix_kernels.push_back(kernel_functions[j]);
+      ++m;
+    } else {
+      if (x_selected.is_empty()) x_selected = x.cols(selected_x_columns);
+      kernel_moments[j] =
+        generateKernelMoments(x_selected, kernel_functions[j], landmark_rows);
+    }
+  }
+  if (!matrix_kernels.empty()) {
+    updateKernelSums(kernel_sums, x, selected_x_columns, matrix_kernels);
+    addMatrixKernelMoments(kernel_moments, kernel_sums, kernel_functions,
+                           matrix_indices, kernel_storage);
+  }
+  return kernel_moments;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+/* Generates the quantities of a candidate kernel needed by
+ estimateSignalToNoise, exactly or from a low-rank approximation
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_GENERATEKERNELMOMENTS_H_
+#define AMKAT_SRC_GENERATEKERNELMOMENTS_H_
+
+#include <string>
+#include <vector>
+
+#include "computeKernelMoments.h"
+#include "computeKernelSums.h"
+
+KernelMoments generateKernelMoments(const arma::mat& x,
+                                    const std::string& kernel_function,
+                                    const arma::uvec& landmark_rows);
+
+std::vector<KernelMoments> generateAllKernelMoments(
+    const arma::mat& x,
+    const std::vector<std::string>& kernel_functions,
+    const arma::uvec& landmark_rows,
+    KernelStorage kernel_storage);
+
+std::vector<KernelMoments> updateAllKernelMoments(
+    KernelSums& kernel_sums,
+    const arma::mat& x,
+    const arma::uvec& selected_x_columns,
+    const std::vector<std::string>& kernel_functions,
+    const arma::uvec& landmark_rows,
+    KernelStorage kernel_storage);
+
+#endif /* AMKAT_SRC_GENERATEKERNELMOMENTS_H_ */
\ No newline at end of file
@@ -0,0 +1,116 @@
+/* Generates the observed test statistic and the permutation statistics for
+ each of many y matrices against the same x without the filter, sharing the
+ candidate kernels
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "computeMaxSnrStatistic.h"
+#include "countPermutationExceedances.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
+#include "generatePermutation.h"
+#include "generateMultiPhenotypeStats.h"
+
+using namespace arma;
+
+// 'y_list' and 'y_variances_list' hold one y matrix (with the same number of
+// rows as 'x') and its vector of variances per phenotype; other arguments are
+// as for generatePermStatsNoFilter, with 'max_exceedances' = 0 disabling
+// sequential stopping.
+// Without the filter the kernels depend only on x, so they and their moments
+// are computed once and shared (read-only) by all phenotypes. Phenotypes are
+// distributed over threads and all use the same permutations; each
+// phenotype's permutations run on one thread, so sequential stopping is exact
+// and the results do not depend on the number of threads
+// 'landmark_rows' (0-based rows of 'x') selects Nystrom landmarks for a
+// low-rank kernel approximation; if empty the kernels are exact
+// 'kernel_storage' ("dense", "packed" or "float") selects how exact n x n
+// kernels are held; see packKernelMoments.cpp
+// [[Rcpp::export]]
+Rcpp::List generateMultiPhenotypeStats(
+    const Rcpp::List& y_list,
+    const Rcpp::List& y_variances_list,
+    const arma::mat& x,
+    const Rcpp::CharacterVector& candidate_kernels,
+    int num_permutations,
+    int max_exceedances,
+    int num_threads,
+    const arma::uvec& landmark_rows,
+    const std::string& kernel_storage) {
+  const arma::uword n = x.n_rows;
+  const int num_phenotypes = y_list.size();
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const KernelStorage kernel_storage_mode = getKernelStorage(kernel_storage);
+  std::vector<arma::mat> y_matrices(num_phenotypes);
+  std::vector<arma::vec> y_variances(num_phenotypes);
+  for (int s = 0; s < num_phenotypes; ++s) {
+    y_matrices[s] = Rcpp::as<arma::mat>(y_list[s]);
+    y_variances[s] = Rcpp::as<arma::vec>(y_variances_list[s]);
+  }
+#ifndef _OPENMP
+  num_threads = 1;
+#endif
+
+  // shared across phenotypes
+  const std::vector<KernelMoments> kernel_moments =
+    generateAllKernelMoments(x, kernel_names, landmark_rows,
+                             kernel_storage_mode);
+  const PermutationTable permutations =
+    buildPermutationTable(n, drawPermutationSeed(), num_permutations, false);
+
+  arma::vec test_statistics(num_phenotypes, fill::zeros);
+  arma::vec num_permutations_used(num_phenotypes, fill::zeros);
+  arma::vec num_exceedances(num_phenotypes, fill::zeros);
+  const int block_size = std::min(num_phenotypes, 16 * num_threads);
+  for (int block_start = 0; block_start < num_phenotypes;
+       block_start += block_size) {
+    const int block_end =
+      std::min(block_start + block_size, num_phenotypes);
+#pragma omp parallel num_threads(num_threads)
+    {
+      // per-thread workspace
+      arma::mat y_permuted_rows;
+#pragma omp for schedule(dynamic)
+      for (int s = block_start; s < block_end; ++s) {
+        const arma::mat& y = y_matrices[s];
+        const double test_statistic =
+          computeMaxSnrStatistic(y, y_variances[s], kernel_moments);
+        const ExceedanceCount count = countPermutationExceedances(
+          test_statistic, num_permutations, max_exceedances,
+          [&](int k) -> double {
+            y_permuted_rows =
+              y.rows(getPermutation(permutations, kResponseStream, k));
+            return computeMaxSnrStatistic(y_permuted_rows, y_variances[s],
+                                          kernel_moments);
+          });
+        test_statistics[s] = test_statistic;
+        num_permutations_used[s] = count.num_permutations_used;
+        num_exceedances[s] = count.num_exceedances;
+      }
+    }
+    Rcpp::checkUserInterrupt();
+  }
+  return Rcpp::List::create(
+    Rcpp::Named("test_statistic") = test_statistics,
+    Rcpp::Named("number_of_permutations") = num_permutations_used,
+    Rcpp::Named("number_of_exceedances") = num_exceedances);
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+/* Approximates the mean and variance of the AMKAT test statistic (without the
+ filter) under the permutation null distribution
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "computeMaxSnrNullMoments.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
+#include "generateNullMomentsNoFilter.h"
+
+// Arguments are as for generateTestStatNoFilter; see
+// computeMaxSnrNullMoments.cpp for the approximation
+// [[Rcpp::export]]
+Rcpp::List generateNullMomentsNoFilter(
+    const arma::mat& y,
+    const arma::vec& y_variances,
+    const arma::mat& x,
+    const Rcpp::CharacterVector& candidate_kernels,
+    const arma::uvec& landmark_rows,
+    const std::string& kernel_storage) {
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const KernelStorage kernel_storage_mode = getKernelStorage(kernel_storage);
+  const std::vector<KernelMoments> kernel_moments =
+    generateAllKernelMoments(x, kernel_names, landmark_rows,
+                             kernel_storage_mode);
+  const arma::vec null_moments =
+    computeMaxSnrNullMoments(y, y_variances, kernel_moments);
+  return Rcpp::List::create(Rcpp::Named("mean") = null_moments[0],
+                            Rcpp::Named("variance") = null_moments[1]);
+}
\ No newline at end of file
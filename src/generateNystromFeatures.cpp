@@ -0,0 +1,49 @@
+/* Computes a Nystrom feature map, whose rows' inner products approximate a
+ kernel function, from a set of landmark rows
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "generateCrossKernelMatrix.h"
+#include "generateNystromFeatures.h"
+
+// Row i of the result is the feature vector of row i of 'x', so that
+// features * features.t() approximates the (uncentered) kernel matrix by
+// K_xm * pinv(K_mm) * K_mx, where m indexes the rows of 'landmarks'.
+// Eigenvalues of K_mm below a relative tolerance are dropped, so the number
+// of columns is at most the number of landmarks
+arma::mat generateNystromFeatures(const arma::mat& x,
+                                  const arma::mat& landmarks,
+                                  const std::string& kernel_function) {
+  const arma::mat landmark_kernel =
+    generateCrossKernelMatrix(landmarks, landmarks, kernel_function);
+  arma::vec eigenvalues;
+  arma::mat eigenvectors;
+  arma::eig_sym(eigenvalues, eigenvectors, arma::symmatu(landmark_kernel));
+  const double tolerance =
+    landmarks.n_rows * arma::datum::eps * std::max(eigenvalues.max(), 0.0);
+  const arma::uvec kept = arma::find(eigenvalues > tolerance);
+  if (kept.is_empty()) {
+    return arma::zeros<arma::mat>(x.n_rows, 1); // the kernel vanishes
+  }
+  const arma::mat inverse_root = eigenvectors.cols(kept) *
+    arma::diagmat(1 / arma::sqrt(eigenvalues.elem(kept)));
+  return generateCrossKernelMatrix(x, landmarks, kernel_function) *
+    inverse_root;
+}
\ No newline at end of file
@@ -20,11 +20,14 @@
 #include <RcppArmadillo.h>
 
 #include "applyAmkatFilter.h"
-#include "testSpearmanRho.h"
-#include "getTailAreaSpearmanRho.h"
-#include "computeSampleRanks.h"
+#include "computeRankCache.h"
+#include "buildSpearmanTailTable.h"
+#include "computeKernelMoments.h"
+#include "computeKernelSums.h"
 #include "estimateSignalToNoise.h"
-#include "generateKernelMatrix.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
+#include "generatePermutation.h"
 
 
 using namespace arma;
@@ -32,39 +35,105 @@ using namespace arma;
 // 'x' and 'y' must have the same number of rows;
 // length of 'y_variances' must match the column dimension of 'y';
 // 'candidate_kernels' must contain values accepted by generateKernelMatrix;
-// 'num_permutations' must be a strictly-positive integer
+// 'num_permutations' and 'num_threads' must be strictly-positive integers
 // see 'AMKAT/src/generateKernelMatrix.cpp'
+// if 'max_exceedances' is positive, permutations stop early (Besag and
+// Clifford, 1991) at the one giving the 'max_exceedances'-th statistic that is
+// at least 'test_statistic', and only the statistics up to it are returned
+// 'landmark_rows' (0-based rows of 'x') selects Nystrom landmarks for a
+// low-rank kernel approximation; if empty the kernels are exact
+// 'kernel_storage' ("dense", "packed" or "float") selects how exact n x n
+// kernels are held; see packKernelMoments.cpp
 // [[Rcpp::export]]
 arma::vec generatePermStats(const arma::mat& y,
                             const arma::vec& y_variances,
                             const arma::mat& x,
                             const Rcpp::CharacterVector& candidate_kernels,
-                            int num_permutations) {
+                            int num_permutations,
+                            int num_threads,
+                            double test_statistic,
+                            int max_exceedances,
+                            const arma::uvec& landmark_rows,
+                            const std::string& kernel_storage) {
   const int n = x.n_rows;
   const int num_kernels = candidate_kernels.size();
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const KernelStorage kernel_storage_mode = getKernelStorage(kernel_storage);
   const int num_y_variables = y.n_cols;
   arma::vec permutation_stats(num_permutations, fill::zeros);
-  arma::mat signal_to_noise(num_kernels, num_y_variables);
-  arma::mat kernel_matrix(n, n);
-  arma::mat y_permuted_rows(y);
-  uword index_of_max_snr;
-  for (int k = 0; k < num_permutations; ++k) {
-    y_permuted_rows = y.rows(randperm(n));
-    uvec selected_x_columns = applyAmkatFilter(y_permuted_rows, x);
-    for (int j = 0; j < num_kernels; ++j) {
-      kernel_matrix =
-        generateKernelMatrix(x.cols(selected_x_columns), candidate_kernels[j]);
-      for (int i = 0; i < num_y_variables; ++i) {
-        signal_to_noise(j, i) =
-          estimateSignalToNoise(y_permuted_rows.col(i), y_variances[i],
-                                kernel_matrix);
+#ifndef _OPENMP
+  num_threads = 1;
+#endif
+
+  // permutation k (of 'y' and of the filter's reference copy of 'x') is a
+  // function of (seed, k) only, so the statistics do not depend on the number
+  // of threads or on scheduling. The seed is the only draw from R's RNG.
+  // Permutations are processed in blocks so that this (coordinating) thread
+  // can check for interrupts between blocks
+  const uint64_t seed = drawPermutationSeed();
+  int num_exceedances = 0;
+  // the samples are ranked once; the filter only relabels the cached ranks
+  const RankCache y_ranks = computeRankCache(y);
+  const RankCache x_ranks = computeRankCache(x);
+  const SpearmanTailTable tail_table =
+    buildSpearmanTailTable(x.n_rows, y_ranks, x_ranks,
+                           countFilterQueries(y.n_cols, x.n_cols,
+                                              num_permutations));
+  // each thread takes runs of kKernelUpdateChunkSize consecutive
+  // permutations and updates the kernels incrementally within a run (see
+  // computeKernelSums.h); a block holds a whole number of runs
+  const int block_size = 4 * kKernelUpdateChunkSize * num_threads;
+  for (int block_start = 0; block_start < num_permutations;
+       block_start += block_size) {
+    const int block_end = std::min(block_start + block_size, num_permutations);
+#pragma omp parallel num_threads(num_threads)
+    {
+      // per-thread workspace
+      arma::mat y_permuted_rows(y);
+      arma::uvec y_row_order(n);
+      arma::mat signal_to_noise(num_kernels, num_y_variables);
+      std::vector<KernelMoments> kernel_moments;
+      KernelSums kernel_sums;
+      uword index_of_max_snr;
+#pragma omp for schedule(dynamic)
+      for (int chunk_start = block_start; chunk_start < block_end;
+           chunk_start += kKernelUpdateChunkSize) {
+        const int chunk_end =
+          std::min(chunk_start + kKernelUpdateChunkSize, block_end);
+        kernel_sums = KernelSums(); // each run starts from a rebuild
+        for (int k = chunk_start; k < chunk_end; ++k) {
+          y_row_order = generatePermutation(n, seed, kResponseStream, k);
+          y_permuted_rows = y.rows(y_row_order);
+          uvec selected_x_columns = applyAmkatFilterToRanks(
+            y_ranks, y_row_order, x_ranks,
+            generatePermutation(n, seed, kFilterReferenceStream, k),
+            tail_table);
+          kernel_moments = updateAllKernelMoments(
+            kernel_sums, x, selected_x_columns, kernel_names, landmark_rows,
+            kernel_storage_mode);
+          for (int j = 0; j < num_kernels; ++j) {
+            signal_to_noise.row(j) = estimateSignalToNoiseColumns(
+              y_permuted_rows, y_variances, kernel_moments[j]);
+          }
+          for (int i = 0; i < num_y_variables; ++i) {
+            index_of_max_snr = signal_to_noise.col(i).index_max();
+            permutation_stats[k] += signal_to_noise(index_of_max_snr, i);
+          }
+        }
       }
     }
-    for (int i = 0; i < num_y_variables; ++i) {
-      index_of_max_snr = signal_to_noise.col(i).index_max();
-      permutation_stats[k] += signal_to_noise(index_of_max_snr, i);
-    }
     Rcpp::checkUserInterrupt();
+    if (max_exceedances > 0) {
+      // exceedances are counted in permutation order, so the stopping point
+      // does not depend on the block size or number of threads
+      for (int k = block_start; k < block_end; ++k) {
+        if ((test_statistic <= permutation_stats[k]) &&
+            (++num_exceedances == max_exceedances)) {
+          return permutation_stats.head(k + 1);
+        }
+      }
+    }
   }
   return permutation_stats;
 }
\ No newline at end of file
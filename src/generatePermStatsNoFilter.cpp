@@ -20,8 +20,11 @@
 
 #include <RcppArmadillo.h>
 
+#include "computeKernelMoments.h"
 #include "estimateSignalToNoise.h"
-#include "generateKernelMatrix.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
+#include "generatePermutation.h"
 
 using namespace arma;
 
@@ -31,38 +34,113 @@ using namespace arma;
 // lengths of 'y_variances' and of 'candidate_kernels' must both match 
 // the column dimension of 'y';
 // 'candidate_kernels' must contain values accepted by generateKernelMatrix;
-// 'num_permutations' must be a strictly-positive integer
+// 'num_permutations' and 'num_threads' must be strictly-positive integers
 // see 'AMKAT/src/generateKernelMatrix.cpp'
+// if 'max_exceedances' is positive, permutations stop early (Besag and
+// Clifford, 1991) at the one giving the 'max_exceedances'-th statistic that is
+// at least 'test_statistic', and only the statistics up to it are returned
+// 'landmark_rows' (0-based rows of 'x') selects Nystrom landmarks for a
+// low-rank kernel approximation; if empty the kernels are exact
+// 'kernel_storage' ("dense", "packed" or "float") selects how exact n x n
+// kernels are held; see packKernelMoments.cpp
 // [[Rcpp::export]]
 arma::vec generatePermStatsNoFilter
   (const arma::mat& y,
    const arma::vec& y_variances,
    const arma::mat& x,
    const Rcpp::CharacterVector& candidate_kernels,
-   int num_permutations) {
+   int num_permutations,
+   int num_threads,
+   double test_statistic,
+   int max_exceedances,
+   const arma::uvec& landmark_rows,
+   const std::string& kernel_storage) {
   
   const int n = x.n_rows; 
   const int num_kernels = candidate_kernels.size();
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const KernelStorage kernel_storage_mode = getKernelStorage(kernel_storage);
   const int num_y_variables = y.n_cols;
   arma::vec permutation_stats(num_permutations, fill::zeros);
-  arma::mat signal_to_noise(num_kernels, num_y_variables);
-  arma::mat kernel_matrix(n, n);
-  arma::mat y_permuted_rows(y);
-  uword index_of_max_snr;
-  for (int k = 0; k < num_permutations; ++k) {
-    y_permuted_rows = y.rows(randperm(n));
-    for (int j = 0; j < num_kernels; ++j) {
-      kernel_matrix = 
-        generateKernelMatrix(x, candidate_kernels[j]);
-      for (int i = 0; i < num_y_variables; ++i) {
-        signal_to_noise(j, i) = 
-          estimateSignalToNoise(y_permuted_rows.col(i), y_variances[i], 
-                                kernel_matrix);
+#ifndef _OPENMP
+  num_threads = 1;
+#endif
+  
+  // 'x' is not permuted, so each candidate kernel and its y-independent
+  // moments are computed only once
+  const std::vector<KernelMoments> kernel_moments =
+    generateAllKernelMoments(x, kernel_names, landmark_rows,
+                             kernel_storage_mode);
+  
+  // permutation k is a function of (seed, k) only and interrupts are checked
+  // between blocks; see 'AMKAT/src/generatePermStats.cpp'.
+  // Since the kernels are fixed, the permuted copies of y from a batch of
+  // consecutive permutations are stacked side by side, and each kernel's
+  // quadratic forms for the whole batch come from one matrix-matrix product.
+  // Batches hold at most 32 permutations and 2^22 stacked entries (32 MB per
+  // thread); their boundaries depend only on n, the column dimension of 'y'
+  // and the permutation index, so the results do not depend on the number of
+  // threads
+  const uint64_t seed = drawPermutationSeed();
+  int num_exceedances = 0;
+  const int batch_size = std::max(1, std::min(
+    std::min(num_permutations, 32), (1 << 22) / (n * num_y_variables)));
+  const int num_batches = (num_permutations + batch_size - 1) / batch_size;
+  const int block_size = std::min(num_batches, 2 * num_threads);
+  for (int block_start = 0; block_start < num_batches;
+       block_start += block_size) {
+    const int block_end = std::min(block_start + block_size, num_batches);
+#pragma omp parallel num_threads(num_threads)
+    {
+      // per-thread workspace
+      arma::mat y_permuted_rows(n, batch_size * num_y_variables);
+      arma::mat signal_to_noise(num_kernels, batch_size * num_y_variables);
+      const arma::vec batch_variances = repmat(y_variances, batch_size, 1);
+      uword index_of_max_snr;
+#pragma omp for schedule(dynamic)
+      for (int b = block_start; b < block_end; ++b) {
+        const int first_permutation = b * batch_size;
+        const int batch_count =
+          std::min(batch_size, num_permutations - first_permutation);
+        for (int k = 0; k < batch_count; ++k) {
+          y_permuted_rows.cols(k * num_y_variables,
+                               (k + 1) * num_y_variables - 1) =
+            y.rows(generatePermutation(n, seed, kResponseStream,
+                                       first_permutation + k));
+        }
+        // a short final batch uses the leading columns of the workspace
+        const arma::mat y_batch(y_permuted_rows.memptr(), n,
+                                batch_count * num_y_variables, false, true);
+        const arma::vec y_batch_variances =
+          batch_variances.head(batch_count * num_y_variables);
+        for (int j = 0; j < num_kernels; ++j) {
+          signal_to_noise.row(j).head(batch_count * num_y_variables) =
+            estimateSignalToNoiseColumns(y_batch, y_batch_variances,
+                                         kernel_moments[j]);
+        }
+        for (int k = 0; k < batch_count; ++k) {
+          for (int i = 0; i < num_y_variables; ++i) {
+            const int column = k * num_y_variables + i;
+            index_of_max_snr = signal_to_noise.col(column).index_max();
+            permutation_stats[first_permutation + k] +=
+              signal_to_noise(index_of_max_snr, column);
+          }
+        }
       }
     }
-    for (int i = 0; i < num_y_variables; ++i) {
-      index_of_max_snr = signal_to_noise.col(i).index_max();
-      permutation_stats[k] += signal_to_noise(index_of_max_snr, i);
+    Rcpp::checkUserInterrupt();
+    if (max_exceedances > 0) {
+      // exceedances are counted in permutation order, so the stopping point
+      // does not depend on the block size or number of threads
+      const int block_last_permutation =
+        std::min(block_end * batch_size, num_permutations);
+      for (int k = block_start * batch_size; k < block_last_permutation; ++k) {
+        if ((test_statistic <= permutation_stats[k]) &&
+            (++num_exceedances == max_exceedances)) {
+          return permutation_stats.head(k + 1);
+        }
+      }
     }
   }
   return permutation_stats;
@@ -27,6 +27,11 @@ arma::vec generatePermStatsNoFilter
    const arma::vec& y_variances,
    const arma::mat& x,
    const Rcpp::CharacterVector& candidate_kernels,
-   int num_permutations);
+   int num_permutations,
+   int num_threads,
+   double test_statistic,
+   int max_exceedances,
+   const arma::uvec& landmark_rows,
+   const std::string& kernel_storage);
 
 #endif /* AMKAT_SRC_GENERATEPERMSTATSNOFILTER_H_ */
\ No newline at end of file
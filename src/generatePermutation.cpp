@@ -0,0 +1,100 @@
+/* Generates reproducible random permutations from a counter-based RNG
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "generatePermutation.h"
+
+namespace {
+
+inline void multiplyHighLow(uint32_t a, uint32_t b,
+                            uint32_t& high, uint32_t& low) {
+  const uint64_t product = static_cast<uint64_t>(a) * b;
+  high = static_cast<uint32_t>(product >> 32);
+  low = static_cast<uint32_t>(product);
+}
+
+// uniform on [0, 1) with 53 random bits
+inline double toUniform(uint32_t high, uint32_t low) {
+  const uint64_t bits = (static_cast<uint64_t>(high) << 32) | low;
+  return (bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace
+
+// Philox4x32-10 (Salmon, Moraes, Dror and Shaw, 2011): a keyed bijection on
+// 128-bit counters, so the output for a given (key, counter) needs no state
+// carried from previous draws
+PhiloxBlock philox4x32(PhiloxBlock counter, uint32_t key0, uint32_t key1) {
+  for (int round = 0; round < 10; ++round) {
+    uint32_t high0, low0, high1, low1;
+    multiplyHighLow(0xD2511F53u, counter.word[0], high0, low0);
+    multiplyHighLow(0xCD9E8D57u, counter.word[2], high1, low1);
+    const PhiloxBlock next =
+      {{high1 ^ counter.word[1] ^ key0, low1,
+        high0 ^ counter.word[3] ^ key1, low0}};
+    counter = next;
+    key0 += 0x9E3779B9u;
+    key1 += 0xBB67AE85u;
+  }
+  return counter;
+}
+
+// Draws a 64-bit seed from R's RNG, so results follow set.seed(). Uses the R
+// API: call only from the main thread, inside an Rcpp::RNGScope (which every
+// exported function has)
+uint64_t drawPermutationSeed() {
+  const uint64_t high = static_cast<uint32_t>(R::unif_rand() * 4294967296.0);
+  const uint64_t low = static_cast<uint32_t>(R::unif_rand() * 4294967296.0);
+  return (high << 32) | low;
+}
+
+// Permutation number 'index' of the given stream: a Fisher-Yates shuffle of
+// 0, ..., n - 1 whose uniforms come from Philox with key 'seed' and counter
+// (draw, stream, index). The result is a pure function of its arguments, so
+// any permutation can be generated on any thread, in any order
+arma::uvec generatePermutation(arma::uword n,
+                               uint64_t seed,
+                               PermutationStream stream,
+                               uint64_t index) {
+  if (n == 0) return arma::uvec();
+  const uint32_t key0 = static_cast<uint32_t>(seed);
+  const uint32_t key1 = static_cast<uint32_t>(seed >> 32);
+  arma::uvec permutation = arma::regspace<arma::uvec>(0, n - 1);
+  PhiloxBlock counter = {{0, static_cast<uint32_t>(stream),
+                          static_cast<uint32_t>(index),
+                          static_cast<uint32_t>(index >> 32)}};
+  PhiloxBlock random_bits = {{0, 0, 0, 0}};
+  int num_unused_uniforms = 0;
+  for (arma::uword i = n - 1; i > 0; --i) {
+    if (num_unused_uniforms == 0) {
+      random_bits = philox4x32(counter, key0, key1);
+      ++counter.word[0];
+      num_unused_uniforms = 2;
+    }
+    const int offset = 2 * (2 - num_unused_uniforms);
+    --num_unused_uniforms;
+    const double u =
+      toUniform(random_bits.word[offset], random_bits.word[offset + 1]);
+    const arma::uword j =
+      std::min(static_cast<arma::uword>(u * (i + 1)), i);
+    std::swap(permutation[i], permutation[j]);
+  }
+  return permutation;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+/* Generates reproducible random permutations from a counter-based RNG
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_GENERATEPERMUTATION_H_
+#define AMKAT_SRC_GENERATEPERMUTATION_H_
+
+#include <cstdint>
+
+// Independent families of permutations drawn from the same seed
+enum PermutationStream {
+  kResponseStream = 0,                // row orders applied to 'y'
+  kFilterReferenceStream = 1,         // row orders for the filter's copy of 'x'
+  kObservedFilterReferenceStream = 2  // the same, for observed statistics
+                                      // that share a seed with permutations
+};
+
+// 128-bit counter or output block of Philox4x32-10
+struct PhiloxBlock {
+  uint32_t word[4];
+};
+
+PhiloxBlock philox4x32(PhiloxBlock counter, uint32_t key0, uint32_t key1);
+
+// The drivers draw the seed on the main thread and then evaluate
+// permutations in OpenMP loops. Everything called inside those loops (the
+// filter, the kernels and the statistics) must not touch the R API or Rcpp
+// objects; Rmath functions such as Rf_pt are safe
+uint64_t drawPermutationSeed();
+
+arma::uvec generatePermutation(arma::uword n,
+                               uint64_t seed,
+                               PermutationStream stream,
+                               uint64_t index);
+
+#endif /* AMKAT_SRC_GENERATEPERMUTATION_H_ */
\ No newline at end of file
@@ -24,8 +24,10 @@
 #include "testSpearmanRho.h"
 #include "getTailAreaSpearmanRho.h"
 #include "computeSampleRanks.h"
+#include "computeKernelMoments.h"
 #include "estimateSignalToNoise.h"
-#include "generateKernelMatrix.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
 
 using namespace arma;
 
@@ -34,26 +36,36 @@ using namespace arma;
 // the column dimension of 'y';
 // 'candidate_kernels' must contain values accepted by generateKernelMatrix;
 // see 'AMKAT/src/generateKernelMatrix.cpp'
+// 'landmark_rows' (0-based rows of 'x') selects Nystrom landmarks for a
+// low-rank kernel approximation; if empty the kernels are exact
+// 'kernel_storage' ("dense", "packed" or "float") selects how exact n x n
+// kernels are held; see packKernelMoments.cpp
 // [[Rcpp::export]]
 Rcpp::List generateTestStat(const arma::mat& y,
                             const arma::vec& y_variances,
                             const arma::mat& x,
-                            const Rcpp::CharacterVector& candidate_kernels) {
-  const int n = x.n_rows;
+                            const Rcpp::CharacterVector& candidate_kernels,
+                            const arma::uvec& landmark_rows,
+                            const std::string& kernel_storage) {
   const int num_kernels = candidate_kernels.size(); 
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const KernelStorage kernel_storage_mode = getKernelStorage(kernel_storage);
   const int num_y_variables = y.n_cols;        
-  arma::mat kernel_matrix(n, n);
+  std::vector<KernelMoments> kernel_moments;
   arma::mat signal_to_noise(num_kernels, num_y_variables);
   uword index_of_max_snr;
   Rcpp::CharacterVector selected_kernels(num_y_variables);
   double test_statistic = 0;
   uvec selected_x_columns = applyAmkatFilter(y, x);
+  kernel_moments = generateAllKernelMoments(
+    x.cols(selected_x_columns), kernel_names, landmark_rows,
+    kernel_storage_mode);
   for (int j = 0; j < num_kernels; ++j) {
-    kernel_matrix = 
-      generateKernelMatrix(x.cols(selected_x_columns), candidate_kernels[j]);
     for (int i = 0; i < num_y_variables; ++i) {
       signal_to_noise(j, i) = 
-        estimateSignalToNoise(y.col(i), y_variances[i], kernel_matrix);
+        estimateSignalToNoiseFromMoments(y.col(i), y_variances[i],
+                                         kernel_moments[j]);
     }
   }
   for (int i = 0; i < num_y_variables; ++i) {
@@ -25,6 +25,8 @@
 Rcpp::List generateTestStat(const arma::mat& y,
                             const arma::vec& y_variances,
                             const arma::mat& x,
-                            const Rcpp::CharacterVector& candidate_kernels) ;
+                            const Rcpp::CharacterVector& candidate_kernels,
+                            const arma::uvec& landmark_rows,
+                            const std::string& kernel_storage) ;
 
 #endif /* AMKAT_SRC_GENERATETESTSTAT_H_ */
\ No newline at end of file
@@ -21,11 +21,14 @@
 #include <RcppArmadillo.h>
 
 #include "applyAmkatFilter.h"
-#include "testSpearmanRho.h"
-#include "getTailAreaSpearmanRho.h"
-#include "computeSampleRanks.h"
-#include "estimateSignalToNoise.h"
-#include "generateKernelMatrix.h"
+#include "computeRankCache.h"
+#include "buildSpearmanTailTable.h"
+#include "computeKernelMoments.h"
+#include "computeKernelSums.h"
+#include "computeMaxSnrStatistic.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
+#include "generatePermutation.h"
 
 using namespace arma;
 
@@ -33,38 +36,76 @@ using namespace arma;
 // lengths of 'y_variances' and of 'candidate_kernels' must both match 
 // the column dimension of 'y';
 // 'candidate_kernels' must contain values accepted by generateKernelMatrix;
-// 'num_test_statistics' must be a strictly-positive integer
 // see 'AMKAT/src/generateKernelMatrix.cpp';
-// 'num_stats' must be a strictly-positive integer
+// 'num_test_statistics' and 'num_threads' must be strictly-positive integers
+// 'landmark_rows' (0-based rows of 'x') selects Nystrom landmarks for a
+// low-rank kernel approximation; if empty the kernels are exact
+// 'kernel_storage' ("dense", "packed" or "float") selects how exact n x n
+// kernels are held; see packKernelMoments.cpp
 // [[Rcpp::export]]
 arma::vec generateTestStatMultiple(
     const arma::mat& y,
     const arma::vec& y_variances,
     const arma::mat& x,
     const Rcpp::CharacterVector& candidate_kernels,
-    int num_test_statistics) {
+    int num_test_statistics,
+    int num_threads,
+    const arma::uvec& landmark_rows,
+    const std::string& kernel_storage) {
   
-  const int n = x.n_rows;
-  const int num_kernels = candidate_kernels.size(); 
-  const int num_y_variables = y.n_cols;
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const KernelStorage kernel_storage_mode = getKernelStorage(kernel_storage);
   arma::vec test_statistics(num_test_statistics, fill::zeros);
-  arma::mat signal_to_noise(num_kernels, num_y_variables);
-  arma::mat kernel_matrix(n, n);    
-  uword index_of_max_snr;
-  for (int k = 0; k < num_test_statistics; ++k) {
-    arma::uvec selected_x_columns = applyAmkatFilter(y, x);
-    for (int j = 0; j < num_kernels; ++j) {
-      kernel_matrix = 
-        generateKernelMatrix(x.cols(selected_x_columns), candidate_kernels[j]);
-      for (int i = 0; i < num_y_variables; ++i) {
-        signal_to_noise(j, i) = 
-          estimateSignalToNoise(y.col(i), y_variances[i], kernel_matrix);
+#ifndef _OPENMP
+  num_threads = 1;
+#endif
+  // the filter's reference copy of 'x' for repetition k is a function of
+  // (seed, k) only, so the statistics do not depend on the number of threads
+  const uint64_t seed = drawPermutationSeed();
+  // the samples are ranked once; the filter only relabels the cached ranks
+  const RankCache y_ranks = computeRankCache(y);
+  const RankCache x_ranks = computeRankCache(x);
+  const SpearmanTailTable tail_table =
+    buildSpearmanTailTable(x.n_rows, y_ranks, x_ranks,
+                           countFilterQueries(y.n_cols, x.n_cols,
+                                              num_test_statistics));
+  // y and x are the same in every repetition, so their p-values are computed
+  // once and each repetition only redraws the reference copy of x
+  const arma::vec observed_min_pvalues =
+    computeObservedFilterPvalues(y_ranks, x_ranks, tail_table);
+  // runs of kKernelUpdateChunkSize consecutive repetitions update the
+  // kernels incrementally (see computeKernelSums.h)
+  const int block_size = 4 * kKernelUpdateChunkSize * num_threads;
+  for (int block_start = 0; block_start < num_test_statistics;
+       block_start += block_size) {
+    const int block_end =
+      std::min(block_start + block_size, num_test_statistics);
+#pragma omp parallel num_threads(num_threads)
+    {
+      // per-thread workspace
+      std::vector<KernelMoments> kernel_moments;
+      KernelSums kernel_sums;
+#pragma omp for schedule(dynamic)
+      for (int chunk_start = block_start; chunk_start < block_end;
+           chunk_start += kKernelUpdateChunkSize) {
+        const int chunk_end =
+          std::min(chunk_start + kKernelUpdateChunkSize, block_end);
+        kernel_sums = KernelSums(); // each run starts from a rebuild
+        for (int k = chunk_start; k < chunk_end; ++k) {
+          const arma::uvec selected_x_columns = applyAmkatFilterToReference(
+            observed_min_pvalues, y_ranks, x_ranks,
+            generatePermutation(x.n_rows, seed, kFilterReferenceStream, k),
+            tail_table);
+          kernel_moments = updateAllKernelMoments(
+            kernel_sums, x, selected_x_columns, kernel_names, landmark_rows,
+            kernel_storage_mode);
+          test_statistics[k] =
+            computeMaxSnrStatistic(y, y_variances, kernel_moments);
+        }
       }
     }
-    for (int i = 0; i < num_y_variables; ++i) {
-      index_of_max_snr = signal_to_noise.col(i).index_max();
-      test_statistics[k] += signal_to_noise(index_of_max_snr, i);
-    }
+    Rcpp::checkUserInterrupt();
   }
   return test_statistics;
 }
\ No newline at end of file
@@ -27,6 +27,9 @@ arma::vec generateTestStatMultiple(
     const arma::vec& y_variances,
     const arma::mat& x,
     const Rcpp::CharacterVector& candidate_kernels,
-    int num_test_statistics) ;
+    int num_test_statistics,
+    int num_threads,
+    const arma::uvec& landmark_rows,
+    const std::string& kernel_storage) ;
 
 #endif /* AMKAT_SRC_GENERATETESTSTATMULTIPLE_H_ */
\ No newline at end of file
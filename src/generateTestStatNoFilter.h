@@ -26,6 +26,8 @@ Rcpp::List generateTestStatNoFilter(
     const arma::mat& y,
     const arma::vec& y_variances,
     const arma::mat& x,
-    const Rcpp::CharacterVector& candidate_kernels) ;
+    const Rcpp::CharacterVector& candidate_kernels,
+    const arma::uvec& landmark_rows,
+    const std::string& kernel_storage) ;
 
 #endif /* AMKAT_SRC_GENERATETESTSTATNOFILTER_H_ */
\ No newline at end of file
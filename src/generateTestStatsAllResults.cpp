@@ -22,11 +22,14 @@
 #include <RcppArmadillo.h>
 
 #include "applyAmkatFilter.h"
-#include "testSpearmanRho.h"
-#include "getTailAreaSpearmanRho.h"
-#include "computeSampleRanks.h"
+#include "computeRankCache.h"
+#include "buildSpearmanTailTable.h"
+#include "computeKernelMoments.h"
+#include "computeKernelSums.h"
 #include "estimateSignalToNoise.h"
-#include "generateKernelMatrix.h"
+#include "generateKernelMoments.h"
+#include "packKernelMoments.h"
+#include "generatePermutation.h"
 
 using namespace arma;
 
@@ -34,46 +37,99 @@ using namespace arma;
 // lengths of 'y_variances' and of 'candidate_kernels' must both match 
 // the column dimension of 'y';
 // 'candidate_kernels' must contain values accepted by generateKernelMatrix;
-// 'num_test_statistics' must be a strictly-positive integer
 // see 'AMKAT/src/generateKernelMatrix.cpp';
-// 'num_stats' must be a strictly-positive integer
+// 'num_test_statistics' and 'num_threads' must be strictly-positive integers
+// 'landmark_rows' (0-based rows of 'x') selects Nystrom landmarks for a
+// low-rank kernel approximation; if empty the kernels are exact
+// 'kernel_storage' ("dense", "packed" or "float") selects how exact n x n
+// kernels are held; see packKernelMoments.cpp
 // [[Rcpp::export]]
 Rcpp::List generateTestStatsAllResults(
     const arma::mat& y,
     const arma::vec& y_variances,
     const arma::mat& x,
     const Rcpp::CharacterVector& candidate_kernels,
-    int num_test_statistics) {
+    int num_test_statistics,
+    int num_threads,
+    const arma::uvec& landmark_rows,
+    const std::string& kernel_storage) {
   
-  const int n = x.n_rows;
   const int num_kernels = candidate_kernels.size(); 
+  const std::vector<std::string> kernel_names =
+    Rcpp::as<std::vector<std::string> >(candidate_kernels);
+  const KernelStorage kernel_storage_mode = getKernelStorage(kernel_storage);
   const int num_y_variables = y.n_cols;
   arma::vec test_statistics(num_test_statistics, fill::zeros);
-  arma::mat signal_to_noise(num_kernels, num_y_variables);
-  arma::mat kernel_matrix(n, n);    
   arma::mat selected_x_matrix(num_test_statistics, x.n_cols, fill::zeros);
-  Rcpp::CharacterMatrix selected_kernels(num_test_statistics, num_y_variables);
-  uword index_of_max_snr;
-  for (int k = 0; k < num_test_statistics; ++k) {
-    arma::uvec selected_x_columns = applyAmkatFilter(y, x);
-    arma::umat double_indices(2, selected_x_columns.size(), fill::value(k));
-    double_indices.row(1) = arma::conv_to<urowvec>::from(selected_x_columns);
-    const arma::uvec linear_indices = 
-      sub2ind(size(selected_x_matrix), double_indices);
-    selected_x_matrix.elem(linear_indices) = 
-      ones<vec>(selected_x_columns.size());
-    for (int j = 0; j < num_kernels; ++j) {
-      kernel_matrix = generateKernelMatrix(x.cols(selected_x_columns), 
-                                           candidate_kernels[j]);
-      for (int i = 0; i < num_y_variables; ++i) {
-        signal_to_noise(j, i) = 
-          estimateSignalToNoise(y.col(i), y_variances[i], kernel_matrix);
+  // kernel indices are recorded in the parallel loop and converted to names
+  // afterwards, since Rcpp objects must not be touched off the main thread
+  arma::umat selected_kernel_indices(num_test_statistics, num_y_variables);
+#ifndef _OPENMP
+  num_threads = 1;
+#endif
+  // the filter's reference copy of 'x' for repetition k is a function of
+  // (seed, k) only, so the results do not depend on the number of threads
+  const uint64_t seed = drawPermutationSeed();
+  // the samples are ranked once; the filter only relabels the cached ranks
+  const RankCache y_ranks = computeRankCache(y);
+  const RankCache x_ranks = computeRankCache(x);
+  const SpearmanTailTable tail_table =
+    buildSpearmanTailTable(x.n_rows, y_ranks, x_ranks,
+                           countFilterQueries(y.n_cols, x.n_cols,
+                                              num_test_statistics));
+  // y and x are the same in every repetition, so their p-values are computed
+  // once and each repetition only redraws the reference copy of x
+  const arma::vec observed_min_pvalues =
+    computeObservedFilterPvalues(y_ranks, x_ranks, tail_table);
+  // runs of kKernelUpdateChunkSize consecutive repetitions update the
+  // kernels incrementally (see computeKernelSums.h)
+  const int block_size = 4 * kKernelUpdateChunkSize * num_threads;
+  for (int block_start = 0; block_start < num_test_statistics;
+       block_start += block_size) {
+    const int block_end =
+      std::min(block_start + block_size, num_test_statistics);
+#pragma omp parallel num_threads(num_threads)
+    {
+      // per-thread workspace
+      arma::mat signal_to_noise(num_kernels, num_y_variables);
+      std::vector<KernelMoments> kernel_moments;
+      KernelSums kernel_sums;
+      uword index_of_max_snr;
+#pragma omp for schedule(dynamic)
+      for (int chunk_start = block_start; chunk_start < block_end;
+           chunk_start += kKernelUpdateChunkSize) {
+        const int chunk_end =
+          std::min(chunk_start + kKernelUpdateChunkSize, block_end);
+        kernel_sums = KernelSums(); // each run starts from a rebuild
+        for (int k = chunk_start; k < chunk_end; ++k) {
+          const arma::uvec selected_x_columns = applyAmkatFilterToReference(
+            observed_min_pvalues, y_ranks, x_ranks,
+            generatePermutation(x.n_rows, seed, kFilterReferenceStream, k),
+            tail_table);
+          for (arma::uword c = 0; c < selected_x_columns.size(); ++c) {
+            selected_x_matrix(k, selected_x_columns[c]) = 1;
+          }
+          kernel_moments = updateAllKernelMoments(
+            kernel_sums, x, selected_x_columns, kernel_names, landmark_rows,
+            kernel_storage_mode);
+          for (int j = 0; j < num_kernels; ++j) {
+            signal_to_noise.row(j) =
+              estimateSignalToNoiseColumns(y, y_variances, kernel_moments[j]);
+          }
+          for (int i = 0; i < num_y_variables; ++i) {
+            index_of_max_snr = signal_to_noise.col(i).index_max();
+            selected_kernel_indices(k, i) = index_of_max_snr;
+            test_statistics[k] += signal_to_noise(index_of_max_snr, i);
+          }
+        }
       }
     }
+    Rcpp::checkUserInterrupt();
+  }
+  Rcpp::CharacterMatrix selected_kernels(num_test_statistics, num_y_variables);
+  for (int k = 0; k < num_test_statistics; ++k) {
     for (int i = 0; i < num_y_variables; ++i) {
-      index_of_max_snr = signal_to_noise.col(i).index_max();
-      selected_kernels(k, i) = candidate_kernels[index_of_max_snr];
-      test_statistics[k] += signal_to_noise(index_of_max_snr, i);
+      selected_kernels(k, i) = candidate_kernels[selected_kernel_indices(k, i)];
     }
   }
   Rcpp::List output = 
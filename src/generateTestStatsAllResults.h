@@ -28,6 +28,9 @@ Rcpp::List generateTestStatsAllResults(
     const arma::vec& y_variances,
     const arma::mat& x,
     const Rcpp::CharacterVector& candidate_kernels,
-    int num_test_statistics) ;
+    int num_test_statistics,
+    int num_threads,
+    const arma::uvec& landmark_rows,
+    const std::string& kernel_storage) ;
 
 #endif /* AMKAT_SRC_GENERATETESTSTATSALLRESULTS_H_ */
\ No newline at end of file
@@ -0,0 +1,41 @@
+/* Looks up a left-tailed or right-tailed area for the sampling distribution
+ of Spearman's rho in a precomputed table, falling back to AS 89
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "getTailAreaSpearmanRho.h"
+#include "lookupTailAreaSpearmanRho.h"
+
+// Same arguments and result as getTailAreaSpearmanRho; 'q' is answered from
+// 'tail_table' when the table was built for 'n' and 'q' is a tabulated even
+// integer, which is always the case for untied data
+double lookupTailAreaSpearmanRho(double q,
+                                 int n,
+                                 int ltail,
+                                 const SpearmanTailTable& tail_table) {
+  const std::vector<double>& tail =
+    ltail ? tail_table.lower_tail : tail_table.upper_tail;
+  const double index = q / 2;
+  if ((n == tail_table.sample_size) && (index >= 0) &&
+      (index < tail.size()) && (index == std::floor(index))) {
+    return tail[static_cast<std::size_t>(index)];
+  }
+  return getTailAreaSpearmanRho(q, n, ltail);
+}
\ No newline at end of file
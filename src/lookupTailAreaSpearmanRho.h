@@ -0,0 +1,31 @@
+/* Looks up a left-tailed or right-tailed area for the sampling distribution
+ of Spearman's rho in a precomputed table, falling back to AS 89
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_LOOKUPTAILAREASPEARMANRHO_H_
+#define AMKAT_SRC_LOOKUPTAILAREASPEARMANRHO_H_
+
+#include "buildSpearmanTailTable.h"
+
+double lookupTailAreaSpearmanRho(double q,
+                                 int n,
+                                 int ltail,
+                                 const SpearmanTailTable& tail_table);
+
+#endif /* AMKAT_SRC_LOOKUPTAILAREASPEARMANRHO_H_ */
\ No newline at end of file
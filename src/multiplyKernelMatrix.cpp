@@ -0,0 +1,59 @@
+/* Multiplies an exact kernel matrix K0 by a matrix, however K0 is stored
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "multiplyKernelMatrix.h"
+#include "packKernelMoments.h"
+
+namespace {
+
+// columns of the packed upper triangle unpacked per BLAS product
+const arma::uword kPanelWidth = 256;
+
+} // namespace
+
+// Returns K0 * y for an exact K0. A packed K0 is unpacked a panel of columns
+// at a time into a double-precision block U holding rows 0, ..., j of each
+// column j; since K0 is symmetric with a zero diagonal, the panel contributes
+// U * y to the rows above it and U' * y to its own rows, so every product is
+// a BLAS product accumulated in double precision even when K0 is stored in
+// single precision. The extra memory is one n x kPanelWidth block
+arma::mat multiplyKernelMatrix(const KernelMoments& kernel_moments,
+                               const arma::mat& y) {
+  if (!kernel_moments.kernel_matrix_diag0.is_empty()) {
+    return kernel_moments.kernel_matrix_diag0 * y;
+  }
+  const arma::uword sample_size = y.n_rows;
+  arma::mat product(sample_size, y.n_cols, arma::fill::zeros);
+  arma::mat panel;
+  for (arma::uword j_start = 0; j_start < sample_size;
+       j_start += kPanelWidth) {
+    const arma::uword j_end = std::min(j_start + kPanelWidth, sample_size);
+    panel.zeros(j_end, j_end - j_start);
+    for (arma::uword j = j_start; j < j_end; ++j) {
+      panel.col(j - j_start).head(j + 1) =
+        getKernelUpperColumn(kernel_moments, j);
+    }
+    product.head_rows(j_end) += panel * y.rows(j_start, j_end - 1);
+    product.rows(j_start, j_end - 1) += panel.t() * y.head_rows(j_end);
+  }
+  return product;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/* Packs genotype calls coded 0/1/2 into two bit-planes (2 bits per call)
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "packGenotypes.h"
+
+// TRUE if every entry of 'x' is exactly 0, 1 or 2
+bool isGenotypeMatrix(const arma::mat& x) {
+  const double* values = x.memptr();
+  for (arma::uword i = 0; i < x.n_elem; ++i) {
+    if ((values[i] != 0) & (values[i] != 1) & (values[i] != 2)) return false;
+  }
+  return true;
+}
+
+// NOTE: assumes isGenotypeMatrix(x); samples are the rows of 'x'
+PackedGenotypes packGenotypes(const arma::mat& x) {
+  PackedGenotypes packed;
+  packed.num_samples = x.n_rows;
+  packed.num_variants = x.n_cols;
+  packed.words_per_sample = (x.n_cols + 63) / 64;
+  const arma::uword words_per_plane = packed.words_per_sample;
+  packed.bits.assign(2 * words_per_plane * x.n_rows, 0);
+  for (arma::uword v = 0; v < x.n_cols; ++v) {
+    const double* calls = x.colptr(v);
+    const arma::uword word = v / 64;
+    const uint64_t mask = uint64_t(1) << (v % 64);
+    for (arma::uword s = 0; s < x.n_rows; ++s) {
+      uint64_t* sample_bits = &packed.bits[2 * words_per_plane * s];
+      if (calls[s] >= 1) sample_bits[word] |= mask;
+      if (calls[s] == 2) sample_bits[words_per_plane + word] |= mask;
+    }
+  }
+  return packed;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+/* Packs genotype calls coded 0/1/2 into two bit-planes (2 bits per call)
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AMKAT_SRC_PACKGENOTYPES_H_
+#define AMKAT_SRC_PACKGENOTYPES_H_
+
+#include <cstdint>
+#include <vector>
+
+// Each sample occupies 2 * words_per_sample consecutive 64-bit words: first
+// the plane of bits (g >= 1), then the plane of bits (g == 2), one bit per
+// variant. For calls g and h this gives |g - h| = popcount of the XOR of the
+// two planes, so Manhattan distances reduce to XOR and popcount; unused bits
+// at the end of each plane are zero
+struct PackedGenotypes {
+  arma::uword num_samples;
+  arma::uword num_variants;
+  arma::uword words_per_sample;  // per plane
+  std::vector<uint64_t> bits;
+};
+
+bool isGenotypeMatrix(const arma::mat& x);
+
+PackedGenotypes packGenotypes(const arma::mat& x);
+
+#endif /* AMKAT_SRC_PACKGENOTYPES_H_ */
\ No newline at end of file
@@ -0,0 +1,86 @@
+/* Stores an exact kernel matrix K0 as its packed upper triangle, in double or
+ single precision, instead of as a full n x n matrix
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "computeKernelMoments.h"
+#include "packKernelMoments.h"
+
+// 'kernel_storage' is "dense", "packed" or "float" (packed, single precision)
+KernelStorage getKernelStorage(const std::string& kernel_storage) {
+  if (kernel_storage == "packed") return kPackedStorage;
+  if (kernel_storage == "float") return kPackedFloatStorage;
+  return kDenseStorage;
+}
+
+// Entry (i, j) of K0 with i <= j is element j * (j + 1) / 2 + i of the packed
+// vector, so each column of the upper triangle is contiguous. K0 is symmetric,
+// so this halves its storage, and single precision halves it again. The
+// y-independent moments are computed from the full matrix beforehand and stay
+// in double precision; only the quadratic forms in y read the packed entries
+// (see multiplyKernelMatrix.cpp). Kernels held through features are left
+// unchanged
+void packKernelMoments(KernelMoments& kernel_moments,
+                       KernelStorage kernel_storage) {
+  if ((kernel_storage == kDenseStorage) ||
+      kernel_moments.kernel_matrix_diag0.is_empty()) {
+    return;
+  }
+  const arma::mat& ker0 = kernel_moments.kernel_matrix_diag0;
+  const arma::uword sample_size = ker0.n_rows;
+  const arma::uword num_packed = sample_size * (sample_size + 1) / 2;
+  if (kernel_storage == kPackedFloatStorage) {
+    kernel_moments.packed_ker0_float.set_size(num_packed);
+    float* packed_col = kernel_moments.packed_ker0_float.memptr();
+    for (arma::uword j = 0; j < sample_size; ++j) {
+      const double* ker0_col = ker0.colptr(j);
+      for (arma::uword i = 0; i <= j; ++i) {
+        packed_col[i] = static_cast<float>(ker0_col[i]);
+      }
+      packed_col += j + 1;
+    }
+  } else {
+    kernel_moments.packed_ker0.set_size(num_packed);
+    double* packed_col = kernel_moments.packed_ker0.memptr();
+    for (arma::uword j = 0; j < sample_size; ++j) {
+      const double* ker0_col = ker0.colptr(j);
+      for (arma::uword i = 0; i <= j; ++i) {
+        packed_col[i] = ker0_col[i];
+      }
+      packed_col += j + 1;
+    }
+  }
+  kernel_moments.kernel_matrix_diag0.reset();
+}
+
+// Rows 0, ..., j of column j of an exact K0, in double precision, however K0
+// is stored
+arma::vec getKernelUpperColumn(const KernelMoments& kernel_moments,
+                               arma::uword j) {
+  const arma::uword offset = j * (j + 1) / 2;
+  if (!kernel_moments.packed_ker0.is_empty()) {
+    return kernel_moments.packed_ker0.subvec(offset, offset + j);
+  }
+  if (!kernel_moments.packed_ker0_float.is_empty()) {
+    return arma::conv_to<arma::vec>::from(
+      kernel_moments.packed_ker0_float.subvec(offset, offset + j));
+  }
+  return kernel_moments.kernel_matrix_diag0.col(j).head(j + 1);
+}
\ No newline at end of file
@@ -19,44 +19,27 @@
 
 #include <RcppArmadillo.h>
 
-#include "getTailAreaSpearmanRho.h"
-#include "computeSampleRanks.h"
+#include "computeMidRanks.h"
+#include "computePvalueSpearmanRho.h"
 
 using namespace Rcpp;
 
-// The implementation is based on the one found in
-// r-source/src/library/stats/R/cor.test.R
 // NOTE: assumes 'x' and 'y' have the same length
 // [[Rcpp::export]]
 double testSpearmanRho(const arma::vec& x,
                        const arma::vec& y) {
   const int n = x.n_elem;
-  const arma::colvec x_ranks = computeSampleRanks(x);
-  const arma::colvec y_ranks = computeSampleRanks(y);
+  arma::vec x_ranks(n);
+  arma::vec y_ranks(n);
+  RankWorkspace workspace;
+  // ties in either of x or y are found while ranking
+  const bool x_ties =
+    computeMidRanks(x.memptr(), x.n_elem, x_ranks.memptr(), workspace);
+  const bool y_ties =
+    computeMidRanks(y.memptr(), y.n_elem, y_ranks.memptr(), workspace);
   const double rho_spearman = arma::as_scalar(arma::cor(x_ranks, y_ranks));
-  const int left_tailed = (rho_spearman > 0);
-
-  // Are there ties in either of x or y?
-  Rcpp::NumericVector x_unique_values = Rcpp::wrap(x);
-  Rcpp::NumericVector y_unique_values = Rcpp::wrap(y);
-  x_unique_values = Rcpp::unique(x_unique_values);
-  y_unique_values = Rcpp::unique(y_unique_values);
-  const double x_num_unique_values = x_unique_values.size();
-  const double y_num_unique_values = y_unique_values.size();
-  const bool ties = (std::min(x_num_unique_values, y_num_unique_values) < n);
-  double tail_area = 1;
-  if ((n <= 1290) & !ties) {
-    // using algorithm AS 89
-    const double q = (n * (n * n - 1)) * (1 - rho_spearman) / 6;
-    tail_area = getTailAreaSpearmanRho(round(q) + (2 * left_tailed),
-                                       n, left_tailed);
-  } else {
-    // using Student's t
-    // Rf_pt calls pt() in R, but is missing the ncp argument;
-    // thus args are Rf_pt(quantile, df, lower.tail, log.p)
-    tail_area =
-      Rf_pt(rho_spearman / sqrt((1 - rho_spearman * rho_spearman) / (n - 2)),
-            n - 2, !left_tailed, 0);
-  }
-  return (std::min(1.0, 2 * tail_area));
+  // a single test makes too few queries to repay building an AS 89 table
+  const SpearmanTailTable no_tail_table;
+  return computePvalueSpearmanRho(rho_spearman, n, x_ties | y_ties,
+                                  no_tail_table);
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+/* Runs Philox4x32-10 on a given counter and key, for comparison with the
+ published known-answer tests
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include "generatePermutation.h"
+#include "validatePhilox.h"
+
+// 'counter' holds four and 'key' two 32-bit words, as doubles; returns the
+// four output words. Only used for validation
+// [[Rcpp::export]]
+arma::vec validatePhilox(const arma::vec& counter, const arma::vec& key) {
+  PhiloxBlock block;
+  for (int i = 0; i < 4; ++i) {
+    block.word[i] = static_cast<uint32_t>(counter[i]);
+  }
+  block = philox4x32(block, static_cast<uint32_t>(key[0]),
+                     static_cast<uint32_t>(key[1]));
+  arma::vec output(4);
+  for (int i = 0; i < 4; ++i) output[i] = block.word[i];
+  return output;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/* Compares the double-double evaluation of the signal-to-noise variance term
+ against a 100-digit MPFR evaluation on the same inputs
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+// Using mpf_float_100 type for increased precision (from boost header package)
+// mpf_float types use mpfr and gmp libraries from BH (boost header) package;
+// need flags for linking -lmpfr -lgmp to PKG_LIBS in makevars and makevars.win
+#include <boost/multiprecision/mpfr.hpp>
+namespace mp = boost::multiprecision;
+
+#include "computeKernelMoments.h"
+#include "computeSnrVariance.h"
+#include "validateSnrVariance.h"
+
+using namespace arma;
+
+// Same arguments and assumptions as estimateSignalToNoise. Only used for
+// validation; the statistic itself never goes through MPFR
+// [[Rcpp::export]]
+Rcpp::List validateSnrVariance(const arma::vec& y,
+                               double y_variance,
+                               const arma::mat& kernel_matrix) {
+  const int n = y.size();
+  const KernelMoments kernel_moments = computeKernelMoments(kernel_matrix);
+  const arma::vec y_standardized = y/sqrt(y_variance);
+  const arma::vec fourth_power = pow(y_standardized, 4);
+  const double fourth_moment = mean(fourth_power) - 3;
+  const double snr_variance =
+    computeSnrVariance(n, kernel_moments, fourth_moment);
+
+  const mp::mpf_float_100 trace_hk0 = kernel_moments.trace_hk0;
+  const mp::mpf_float_100 trace_hk0h_hadamard =
+    kernel_moments.trace_hk0h_hadamard;
+  const mp::mpf_float_100 squared_trace_hk0 = trace_hk0 * trace_hk0;
+  const mp::mpf_float_100 trace_hk0hk0 = kernel_moments.trace_hk0hk0;
+  const mp::mpf_float_100 n_float(n);
+  const mp::mpf_float_100 fourth_moment_float = fourth_moment;
+  const mp::mpf_float_100 snr_variance_float =
+    (2 - 12 / (n_float - 1)) * trace_hk0hk0 -
+    (2 / n_float) * squared_trace_hk0 +
+    fourth_moment_float * ((6 / n_float) * trace_hk0hk0 +
+    (1 / n_float) * squared_trace_hk0 + trace_hk0h_hadamard);
+  const double snr_variance_mpfr = snr_variance_float.convert_to<double>();
+  const mp::mpf_float_100 relative_difference =
+    abs((snr_variance - snr_variance_float) / snr_variance_float);
+
+  Rcpp::List output = Rcpp::List::create(
+    Rcpp::Named("snr_variance") = snr_variance,
+    Rcpp::Named("snr_variance_mpfr") = snr_variance_mpfr,
+    Rcpp::Named("relative_difference") =
+      relative_difference.convert_to<double>());
+  return output;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+/* Compares the tabulated AS 89 tail areas of the Spearman correlation with
+ direct evaluations of the series
+
+ AMKAT package for R
+ Copyright (C) 2021, Brian Neal
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <RcppArmadillo.h>
+
+#include <cstring>
+
+#include "buildSpearmanTailTable.h"
+#include "getTailAreaSpearmanRho.h"
+#include "lookupTailAreaSpearmanRho.h"
+#include "validateSpearmanTailTable.h"
+
+// Builds the table for tie-free samples of size 'n' and looks up both tails at
+// every even statistic it covers. Only used for validation; returns the
+// number of entries compared and the number that differ in any bit from
+// getTailAreaSpearmanRho
+// [[Rcpp::export]]
+Rcpp::List validateSpearmanTailTable(int n) {
+  RankCache tie_free_ranks;
+  tie_free_ranks.has_ties.zeros(1);
+  const SpearmanTailTable tail_table = buildSpearmanTailTable(
+    n, tie_free_ranks, tie_free_ranks, arma::datum::inf);
+  int num_compared = 0;
+  int num_different = 0;
+  for (std::size_t k = 0; k < tail_table.upper_tail.size(); ++k) {
+    for (int ltail = 0; ltail < 2; ++ltail) {
+      const double tabulated =
+        lookupTailAreaSpearmanRho(2. * k, n, ltail, tail_table);
+      const double direct = getTailAreaSpearmanRho(2. * k, n, ltail);
+      ++num_compared;
+      if (std::memcmp(&tabulated, &direct, sizeof(double)) != 0) {
+        ++num_different;
+      }
+    }
+  }
+  return Rcpp::List::create(
+    Rcpp::Named("table_size") = int(tail_table.upper_tail.size()),
+    Rcpp::Named("number_compared") = num_compared,
+    Rcpp::Named("number_different") = num_different);
+}
\ No newline at end of file